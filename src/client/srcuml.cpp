@@ -21,17 +21,40 @@
 
  /*
 
-  Count each the occurrences of each srcML element.
+  Generate a UML class diagram from a srcML archive, or directly from
+  source files and directories which are converted to srcML in memory.
 
-  Input: input_file.xml
-  Useage: srcuml input_file.xml
+  Input: input_file.xml | model_file | source files and directories
+  Options: --jobs N, --no-dependencies, --include pattern, --exclude pattern,
+           --exclude-unit pattern, --type-config config_file, --cache cache_file,
+           --model model_file, --format format[,format...]
+  Useage: srcuml [options] input_file.xml [output_file]
+          srcuml [options] [--output output_file] source...
+          srcuml [--output output_file] model_file
+          srcuml [options] --format dot,yuml --output dot_file --output yuml_file input...
   
   */
 
 #include <srcuml_handler.hpp>
 
+#include <tclap/CmdLine.h>
+
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+
+static bool has_extension(const std::string & filename, const std::string & extension) {
+
+  return filename.size() >= extension.size() && filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
+
+}
+
+/** srcML archives and saved models are read as a single file, anything else is source */
+static bool is_archive_or_model(const std::string & filename) {
+
+  return has_extension(filename, ".xml") || has_extension(filename, ".srcuml");
+
+}
 
 /**
  * main
@@ -42,22 +65,83 @@
  */
 int main(int argc, char * argv[]) {
 
-  if(argc < 2) {
+  TCLAP::CmdLine cmd("Generate a UML class diagram from a srcML archive or source code", ' ', "0.1");
+
+  TCLAP::UnlabeledMultiArg<std::string> input_arg("input", "srcML archive, or source files and directories", true, "input", cmd);
+  TCLAP::MultiArg<std::string> output_arg("o", "output", "file to write, standard output by default, one per format when there are several", false, "output_file", cmd);
+  TCLAP::MultiArg<std::string> format_arg("f", "format", "diagram format, dot (default), yuml, or json (NDJSON records), several are rendered from one analysis", false, "format[,format...]", cmd);
+  TCLAP::ValueArg<std::size_t> jobs_arg("j", "jobs", "number of units to parse in parallel, 0 uses all cores", false, 1, "N", cmd);
+  TCLAP::ValueArg<std::string> cache_arg("c", "cache", "per-unit analysis cache, only changed units are parsed again", false, "", "cache_file", cmd);
+  TCLAP::SwitchArg no_dependencies_arg("", "no-dependencies", "leave out dependencies, function bodies and the classes defined in them are not parsed", cmd, false);
+  TCLAP::MultiArg<std::string> include_arg("", "include", "only diagram classes whose qualified name matches the glob, e.g., 'net::*'", false, "pattern", cmd);
+  TCLAP::MultiArg<std::string> exclude_arg("", "exclude", "leave out classes whose qualified name matches the glob, e.g., '*Test*'", false, "pattern", cmd);
+  TCLAP::MultiArg<std::string> exclude_unit_arg("", "exclude-unit", "do not parse units whose filename matches the glob", false, "pattern", cmd);
+  TCLAP::ValueArg<std::string> type_config_arg("t", "type-config", "file of 'category type_name' lines, e.g., 'unordered_map absl::flat_hash_map' or 'numeric int64_t'", false, "", "config_file", cmd);
+  TCLAP::ValueArg<std::string> model_arg("m", "model", "save the analyzed model, it can be given as input instead of srcML", false, "", "model_file", cmd);
+
+  cmd.parse(argc, argv);
+
+  srcuml_options options;
+  options.jobs = jobs_arg.getValue();
+  options.dependencies = !no_dependencies_arg.getValue();
+  options.includes = include_arg.getValue();
+  options.excludes = exclude_arg.getValue();
+  options.unit_excludes = exclude_unit_arg.getValue();
+  options.type_config = type_config_arg.getValue();
+  options.cache_file = cache_arg.getValue();
+  options.model_file = model_arg.getValue();
 
-    std::cerr << "Usage: srcuml input_file.xml [output_file]\n";
-    exit(1);
+  std::vector<std::string> inputs = input_arg.getValue();
+  std::vector<std::string> outputs = output_arg.getValue();
+
+  // srcuml input_file.xml output_file
+  if(outputs.empty() && inputs.size() == 2 && is_archive_or_model(inputs.front())) {
+
+    outputs.push_back(inputs.back());
+    inputs.pop_back();
+
+  }
+
+  // a single diagram goes to the output stream, several each to their own file
+  std::string output_filename;
+  try {
+
+    output_filename = options.add_outputs(format_arg.getValue(), outputs);
+
+  } catch(const std::exception & error) {
+
+    std::cerr << "srcuml: " << error.what() << '\n';
+    return 1;
 
   }
 
   std::ostream * out = &std::cout;
   
-  if(argc > 2)
-    out = new std::ofstream(argv[2]);
+  if(!output_filename.empty())
+    out = new std::ofstream(output_filename);
+
+  int status = 0;
+  try {
+
+    if(inputs.size() == 1 && is_archive_or_model(inputs.front())) {
 
-  srcuml_handler handler(argv[1], *out);
+      srcuml_handler handler(inputs.front().c_str(), *out, options);
+
+    } else {
+
+      srcuml_handler handler(srcuml_source(inputs), *out, options);
+
+    }
+
+  } catch(const std::exception & error) {
+
+    std::cerr << "srcuml: " << error.what() << '\n';
+    status = 1;
+
+  }
 
-  if(argc > 2)
+  if(out != &std::cout)
     delete out;
 
-  return 0;
+  return status;
 }
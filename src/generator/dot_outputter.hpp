@@ -24,111 +24,131 @@
 
 #include <srcuml_outputter.hpp>
 
-class dot_outputter : srcuml_outputter {
+class dot_outputter : public srcuml_outputter {
 
 public:
 
-	dot_outputter(){};
+	dot_outputter(std::size_t jobs = 1) : srcuml_outputter(jobs) {};
 
-	bool output(std::ostream & out, std::vector<std::shared_ptr<srcuml_class>> & classes){
+	using srcuml_outputter::output;
 
-		srcuml_relationships relationships = analyze_relationships(classes);
+	bool output(std::ostream & stream, std::vector<srcuml_class *> & classes, srcuml_relationships & relationships){
 
-		out << "digraph hierarchy {\n";//size=\"5, 5\"\n";
-        out << "node[shape=record,style=filled,fillcolor=gray95]\n";
-        out << "edge[dir=\"both\", arrowtail=\"empty\", arrowhead=\"empty\", labeldistance=\"2.0\"]\n";
+		srcuml_output_buffer out(stream);
+		out.reserve(classes.size() * CLASS_SIZE_HINT + relationships.get_relationships().size() * RELATIONSHIP_SIZE_HINT);
 
-        std::map<std::string, std::string> class_number_map;
+		output_header(out);
 
-        int class_num = 0;
-        std::string class_word = "class";
+        srcuml_thread_pool pool(jobs);
 
         //Classes
 
-        for(const std::shared_ptr<srcuml_class> & aclass : classes) {
-
-            std::string class_wn = class_word + std::to_string(class_num);
-
-        	class_number_map.insert(std::pair<std::string, std::string>(aclass->get_srcuml_name(), class_wn));
-
-    		out << class_wn << "[label = \"{ ";
-    		out << aclass->get_srcuml_name();
-    		if(aclass->get_has_field() || aclass->get_has_method())//private members
-            	out << '|';
-
-        	for(const srcuml_attribute & attribute : aclass->get_attributes()) {//private members
-            	if(attribute.get_is_static()) {
-                	static_outputter::output(out, attribute);
-            	} else {
-                	out << attribute;
-            	}
-            	out << "\\n";
-        	}
-
-        	if(aclass->get_has_method())//private members
-            	out << '|';
-
-        	for(std::size_t access = 0; access <= ClassPolicy::PROTECTED; ++access) {
-            	for(const FunctionPolicy::FunctionData * function : aclass->get_data().methods[access]) { //private members
-                	srcuml_operation op(function, (ClassPolicy::AccessSpecifier)access);
-                	if(op.get_stereotypes().count("set") > 0){continue;}
-                	if(op.get_stereotypes().count("get") > 0){continue;}
-                	if(function->isStatic) {
-                    	static_outputter::output(out, op);
-                	} else {
-                    	out << op;
-                	}
-                	out << "\\n";
-            	}
-        	}
-
-        	out << "}\"]\n";
-            class_num++;
-        }
+        render(pool, out, classes.size(), [&](srcuml_output_buffer & buffer, std::size_t class_num) {
+            output_class(buffer, class_num, classes[class_num]);
+        });
 
         //Relations
 
-        for(const srcuml_relationship relationship : relationships.get_relationships()) {
-            
-        	const std::map<std::string, std::string>::const_iterator current_class = class_number_map.find(relationship.get_source());
-        	out << current_class->second << "->";
-        	const std::map<std::string, std::string>::const_iterator second_class = class_number_map.find(relationship.get_destination());
-        	out << second_class->second;
-
-        	switch(relationship.type) {
-
-            	case DEPENDENCY: {
-                	out << "[arrowhead=\"vee\", arrowtail=\"none\", style=\"dashed\"]\n";
-                	break;
-            	}
-            	case ASSOCIATION:
-            	case BIDIRECTIONAL: {
-                	out << "[arrowhead=\"none\"]\n"; //currently same as generalization
-                	break;
-	            }
-    	        case AGGREGATION: {
-        	        out << "[arrowhead=\"none\", arrowtail=\"odiamond\"]\n";
-            	    break;
-            	}
-            	case COMPOSITION: {
-                	out << "[arrowhead=\"vee\", arrowtail=\"diamond\"]\n";
-                	break;
-            	}
-            	case GENERALIZATION: {
-                	out << "[arrowhead=\"none\"]\n";
-                	break;
-            	}
-            	case REALIZATION: {
-                	out << "[arrowhead=\"none\", style=\"dashed\"]\n";
-                	break;
-            	}
-
-        	}
-
-        }
+        const std::vector<srcuml_relationship> & edges = relationships.get_relationships();
+        render(pool, out, edges.size(), [&](srcuml_output_buffer & buffer, std::size_t edge) {
+            output_relationship(buffer, edges[edge]);
+        });
 
         out << '}' << '\n';
 
+        return true;
+
+	}
+
+private:
+
+	static void output_class(srcuml_output_buffer & out, std::size_t class_num, const srcuml_class * aclass) {
+
+		out << "class" << class_num << "[label = \"{ ";
+		out << aclass->get_srcuml_name();
+		if(aclass->get_has_field() || aclass->get_has_method())//private members
+			out << '|';
+
+		for(const srcuml_attribute & attribute : aclass->get_attributes()) {//private members
+			if(attribute.get_is_static()) {
+				static_outputter::output(out, attribute);
+			} else {
+				out << attribute;
+			}
+			out << "\\n";
+		}
+
+		if(aclass->get_has_method())//private members
+			out << '|';
+
+		for(const srcuml_operation & op : aclass->get_operations()) { //private members
+			if(op.has_stereotype(srcuml_operation::ACCESSOR)) continue;
+			if(op.get_is_static()) {
+				static_outputter::output(out, op);
+			} else {
+				out << op;
+			}
+			out << "\\n";
+		}
+
+		out << "}\"]\n";
+
+	}
+
+protected:
+
+	static void output_header(srcuml_output_buffer & out) {
+
+		out << "digraph hierarchy {\n";//size=\"5, 5\"\n";
+		out << "node[shape=record,style=filled,fillcolor=gray95]\n";
+		out << "edge[dir=\"both\", arrowtail=\"empty\", arrowhead=\"empty\", labeldistance=\"2.0\"]\n";
+
+	}
+
+	/** node ids are class positions, so they are also the class numbers */
+	static void output_relationship(srcuml_output_buffer & out, const srcuml_relationship & relationship) {
+
+		out << "class" << relationship.get_source_node() << "->";
+		out << "class" << relationship.get_destination_node();
+
+		switch(relationship.type) {
+
+			case DEPENDENCY: {
+				out << "[arrowhead=\"vee\", arrowtail=\"none\", style=\"dashed\"";
+				// one edge stands for every use, label the repeated ones
+				if(relationship.get_weight() > 1) {
+					out << ", weight=\"" << relationship.get_weight() << "\", label=\"" << relationship.get_weight() << "\"";
+					out << ", tooltip=\"" << relationship.get_uses(srcuml_relationship::PARAMETER_USE) << " parameter, "
+						<< relationship.get_uses(srcuml_relationship::LOCAL_USE) << " local, "
+						<< relationship.get_uses(srcuml_relationship::RETURN_USE) << " return\"";
+				}
+				out << "]\n";
+				break;
+			}
+			case ASSOCIATION:
+			case BIDIRECTIONAL: {
+				out << "[arrowhead=\"none\"]\n"; //currently same as generalization
+				break;
+			}
+			case AGGREGATION: {
+				out << "[arrowhead=\"none\", arrowtail=\"odiamond\"]\n";
+				break;
+			}
+			case COMPOSITION: {
+				out << "[arrowhead=\"vee\", arrowtail=\"diamond\"]\n";
+				break;
+			}
+			case GENERALIZATION: {
+				out << "[arrowhead=\"none\"]\n";
+				break;
+			}
+			case REALIZATION: {
+				out << "[arrowhead=\"none\", style=\"dashed\"]\n";
+				break;
+			}
+
+		}
+
 	}
 
 };
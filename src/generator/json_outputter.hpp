@@ -0,0 +1,267 @@
+/**
+ * @file json_outputter.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INCLUDED_JSON_OUTPUTTER_HPP
+#define INCLUDED_JSON_OUTPUTTER_HPP
+
+#include <srcuml_outputter.hpp>
+
+/**
+ * json_outputter
+ *
+ * Streams the model as NDJSON, one record per line: a model record with
+ * the counts, a class record per class with its members, then a
+ * relationship record per edge.  Class ids are class positions, which the
+ * relationships refer to.  Records are written straight into the output
+ * buffer, text is only copied when it has characters to escape.
+ */
+class json_outputter : public srcuml_outputter {
+
+public:
+
+	json_outputter(std::size_t jobs = 1) : srcuml_outputter(jobs) {};
+
+	using srcuml_outputter::output;
+
+	bool output(std::ostream & stream, std::vector<srcuml_class *> & classes, srcuml_relationships & relationships){
+
+		const std::vector<srcuml_relationship> & edges = relationships.get_relationships();
+
+		srcuml_output_buffer out(stream);
+		out.reserve(classes.size() * CLASS_SIZE_HINT * 2 + edges.size() * RELATIONSHIP_SIZE_HINT * 2);
+
+		out << "{\"record\":\"model\",\"classes\":" << classes.size() << ",\"relationships\":" << edges.size() << "}\n";
+
+		srcuml_thread_pool pool(jobs);
+
+		render(pool, out, classes.size(), [&](srcuml_output_buffer & buffer, std::size_t class_num) {
+			output_class(buffer, class_num, classes[class_num]);
+		});
+
+		render(pool, out, edges.size(), [&](srcuml_output_buffer & buffer, std::size_t edge) {
+			output_relationship(buffer, edges[edge]);
+		});
+
+		return true;
+
+	}
+
+private:
+
+	static void output_class(srcuml_output_buffer & out, std::size_t class_num, const srcuml_class * aclass) {
+
+		out << "{\"record\":\"class\",\"id\":" << class_num << ",\"name\":";
+		output_string(out, aclass->get_name());
+		out << ",\"namespace\":";
+		output_string(out, aclass->get_namespace_symbol());
+		out << ",\"interface\":" << get_bool_name(aclass->get_is_interface());
+		out << ",\"abstract\":" << get_bool_name(aclass->get_is_abstract());
+		out << ",\"datatype\":" << get_bool_name(aclass->get_is_datatype());
+
+		out << ",\"parents\":[";
+		for(std::size_t pos = 0; pos < aclass->get_parents().size(); ++pos) {
+
+			if(pos != 0) out << ',';
+			output_string(out, aclass->get_parents()[pos]);
+
+		}
+
+		out << "],\"attributes\":[";
+		for(std::size_t pos = 0; pos < aclass->get_attributes().size(); ++pos) {
+
+			const srcuml_attribute & attribute = aclass->get_attributes()[pos];
+			if(pos != 0) out << ',';
+
+			out << "{\"name\":";
+			output_string(out, attribute.get_name());
+			output_type(out, "type", "numeric", attribute.get_type());
+			out << ",\"multiplicity\":";
+			output_string(out, attribute.get_multiplicity());
+			out << ",\"visibility\":\"" << get_visibility_name(attribute.get_visibility()) << '"';
+			out << ",\"static\":" << get_bool_name(attribute.get_is_static()) << '}';
+
+		}
+
+		out << "],\"operations\":[";
+		for(std::size_t pos = 0; pos < aclass->get_operations().size(); ++pos) {
+
+			const srcuml_operation & op = aclass->get_operations()[pos];
+			if(pos != 0) out << ',';
+
+			out << "{\"name\":";
+			output_string(out, op.get_name());
+			if(op.get_has_return_type())
+				output_type(out, "return_type", "return_numeric", op.get_return_type());
+			else
+				out << ",\"return_type\":null,\"return_numeric\":false";
+
+			out << ",\"parameters\":[";
+			for(std::size_t param = 0; param < op.get_parameters().size(); ++param) {
+
+				const srcuml_parameter & parameter = op.get_parameters()[param];
+				if(param != 0) out << ',';
+
+				out << "{\"name\":";
+				output_string(out, parameter.get_name());
+				output_type(out, "type", "numeric", parameter.get_type());
+				out << ",\"multiplicity\":";
+				output_string(out, parameter.get_multiplicity());
+				out << '}';
+
+			}
+
+			out << "],\"visibility\":\"" << get_visibility_name(op.get_visibility()) << '"';
+			out << ",\"static\":" << get_bool_name(op.get_is_static());
+			out << ",\"const\":" << get_bool_name(op.get_is_const());
+			out << ",\"pure_virtual\":" << get_bool_name(op.get_is_pure_virtual());
+
+			out << ",\"stereotype\":";
+			output_string(out, op.get_stereotype());
+			out << ",\"stereotypes\":[";
+			bool first = true;
+			for(const std::pair<const char *, srcuml_operation::stereotype_flag> & name : srcuml_operation::get_stereotype_names()) {
+
+				if(!op.has_stereotype(name.second)) continue;
+				if(!first) out << ',';
+				out << '"' << name.first << '"';
+				first = false;
+
+			}
+
+			out << "]}";
+
+		}
+
+		out << "]}\n";
+
+	}
+
+	static void output_relationship(srcuml_output_buffer & out, const srcuml_relationship & relationship) {
+
+		static const char * const type_names[] = {
+			"dependency", "association", "bidirectional", "aggregation", "composition", "generalization", "realization"
+		};
+
+		out << "{\"record\":\"relationship\",\"type\":\"" << type_names[relationship.type] << '"';
+		out << ",\"source\":" << relationship.get_source_node();
+		out << ",\"destination\":" << relationship.get_destination_node();
+		out << ",\"source_label\":";
+		output_string(out, relationship.get_source_label());
+		out << ",\"destination_label\":";
+		output_string(out, relationship.get_destination_label());
+
+		if(relationship.type == DEPENDENCY) {
+
+			out << ",\"uses\":{\"parameter\":" << relationship.get_uses(srcuml_relationship::PARAMETER_USE);
+			out << ",\"local\":" << relationship.get_uses(srcuml_relationship::LOCAL_USE);
+			out << ",\"return\":" << relationship.get_uses(srcuml_relationship::RETURN_USE) << '}';
+
+		}
+
+		out << "}\n";
+
+	}
+
+	/** the declared type name, numeric types are marked in a field of their own */
+	static void output_type(srcuml_output_buffer & out, const char * type_field, const char * numeric_field, const srcuml_type & type) {
+
+		out << ",\"" << type_field << "\":";
+		output_string(out, type.get_type_name());
+		out << ",\"" << numeric_field << "\":" << get_bool_name(type.get_is_numeric());
+
+	}
+
+	static const char * get_bool_name(bool value) {
+		return value ? "true" : "false";
+	}
+
+	static const char * get_visibility_name(ClassPolicy::AccessSpecifier visibility) {
+
+		if(visibility == ClassPolicy::PUBLIC) return "public";
+		if(visibility == ClassPolicy::PROTECTED) return "protected";
+		return "private";
+
+	}
+
+	/** output t as a JSON string, rendered in place and rewritten only if it needs escapes */
+	template <typename T>
+	static void output_string(srcuml_output_buffer & out, const T & t) {
+
+		out << '"';
+
+		std::size_t begin = out.size();
+		out << t;
+
+		const std::string & text = out.str();
+		std::size_t pos = begin;
+		while(pos < text.size() && !needs_escape(text[pos]))
+			++pos;
+
+		if(pos != text.size()) {
+
+			thread_local std::string str;
+			str.assign(text, pos, std::string::npos);
+			out.truncate(pos);
+
+			for(char character : str) {
+
+				if(!needs_escape(character)) {
+
+					out.put(character);
+					continue;
+
+				}
+
+				out.put('\\');
+				switch(character) {
+
+					case '"':  out.put('"'); break;
+					case '\\': out.put('\\'); break;
+					case '\n': out.put('n'); break;
+					case '\r': out.put('r'); break;
+					case '\t': out.put('t'); break;
+					default: {
+
+						static const char digits[] = "0123456789abcdef";
+						out << "u00";
+						out.put(digits[(unsigned char)character >> 4]);
+						out.put(digits[(unsigned char)character & 0xf]);
+
+					}
+
+				}
+
+			}
+
+		}
+
+		out << '"';
+
+	}
+
+	static bool needs_escape(char character) {
+		return character == '"' || character == '\\' || (unsigned char)character < 0x20;
+	}
+
+};
+
+#endif
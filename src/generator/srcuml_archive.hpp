@@ -0,0 +1,202 @@
+/**
+ * @file srcuml_archive.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDED_SRCUML_ARCHIVE_HPP
+#define INCLUDED_SRCUML_ARCHIVE_HPP
+
+#include <srcuml_reader.hpp>
+#include <srcuml_markup.hpp>
+#include <srcuml_utilities.hpp>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cctype>
+
+/**
+ * srcuml_archive
+ *
+ * Splits the text of a srcML archive on its <unit> boundaries without
+ * parsing it.
+ *
+ * Each unit can be turned into a standalone document made of the
+ * xml declaration and root start tag (which carries the namespaces),
+ * the unit, and the root end tag.
+ */
+class srcuml_archive {
+
+public:
+
+    struct unit {
+
+        std::size_t begin;
+        std::size_t end;
+
+    };
+
+private:
+
+    const char * buffer;
+    std::size_t buffer_size;
+    srcuml_markup markup;
+
+    std::string root_name;
+    std::size_t root_begin;
+    std::size_t root_end;
+    std::string footer;
+
+    std::vector<unit> units;
+
+public:
+
+    srcuml_archive(const char * buffer, std::size_t size)
+        : buffer(buffer),
+          buffer_size(size),
+          markup(buffer, size),
+          root_name(),
+          root_begin(0),
+          root_end(0),
+          footer(),
+          units() {
+
+            split();
+
+    }
+
+    /** false for a single non-archive unit, which should be parsed whole */
+    bool is_archive() const {
+        return !units.empty();
+    }
+
+    std::size_t size() const {
+        return units.size();
+    }
+
+    const unit & get_unit(std::size_t pos) const {
+        return units[pos];
+    }
+
+    /** value of the unit's filename attribute, empty if it has none */
+    std::string get_filename(std::size_t pos) const {
+
+        return get_filename_attribute(units[pos].begin);
+
+    }
+
+    /** filename attribute of the root, i.e., of a single non-archive unit */
+    std::string get_root_filename() const {
+
+        return root_end ? get_filename_attribute(root_begin) : std::string();
+
+    }
+
+    /** hash of the unit's text, used to detect changed units */
+    std::uint64_t get_hash(std::size_t pos) const {
+
+        const unit & the_unit = units[pos];
+        return srcuml::hash(buffer + the_unit.begin, the_unit.end - the_unit.begin);
+
+    }
+
+    /** queue the standalone document for a unit, nothing is copied */
+    void add_unit_document(srcuml_reader & reader, std::size_t pos) const {
+
+        const unit & the_unit = units[pos];
+
+        reader.add(buffer, root_end);
+        reader.add(buffer + the_unit.begin, the_unit.end - the_unit.begin);
+        reader.add(footer);
+
+    }
+
+private:
+
+    std::string get_filename_attribute(std::size_t tag_begin) const {
+
+        const std::string attribute = " filename=\"";
+
+        std::size_t tag_end = markup.find_tag_end(tag_begin);
+        const char * start = std::search(buffer + tag_begin, buffer + tag_end, attribute.begin(), attribute.end());
+        if(start == buffer + tag_end) return std::string();
+
+        start += attribute.size();
+        const char * end = std::find(start, buffer + tag_end, '"');
+
+        return std::string(start, end);
+
+    }
+
+    void split() {
+
+        std::size_t pos = markup.find_markup(0);
+        while(pos + 1 < buffer_size && (buffer[pos + 1] == '?' || buffer[pos + 1] == '!'))
+            pos = markup.find_markup(markup.find_tag_end(pos));
+
+        if(pos >= buffer_size) return;
+
+        std::size_t name_end = pos + 1;
+        while(name_end < buffer_size && !isspace(buffer[name_end]) && buffer[name_end] != '>' && buffer[name_end] != '/')
+            ++name_end;
+
+        root_name = std::string(buffer + pos + 1, name_end - pos - 1);
+        root_begin = pos;
+        root_end = markup.find_tag_end(pos);
+        if(root_end < 2 || markup.is_empty_tag(root_end)) return;
+
+        footer = "</" + root_name + ">";
+
+        for(pos = markup.find_markup(root_end); pos < buffer_size; pos = markup.find_markup(pos)) {
+
+            if(footer.compare(0, footer.size(), buffer + pos, std::min(footer.size(), buffer_size - pos)) == 0)
+                break;
+
+            // anything other than a nested unit means this is not an archive
+            if(!markup.is_tag(pos + 1, root_name)) {
+                units.clear();
+                return;
+            }
+
+            std::size_t tag_end = markup.find_tag_end(pos);
+            std::size_t unit_end = tag_end;
+            if(!markup.is_empty_tag(tag_end)) {
+
+                for(unit_end = markup.find_markup(tag_end); unit_end < buffer_size; unit_end = markup.find_markup(unit_end + 1)) {
+
+                    if(footer.compare(0, footer.size(), buffer + unit_end, std::min(footer.size(), buffer_size - unit_end)) == 0)
+                        break;
+
+                }
+
+                unit_end = std::min(unit_end + footer.size(), buffer_size);
+
+            }
+
+            units.push_back(unit{ pos, unit_end });
+            pos = unit_end;
+
+        }
+
+    }
+
+};
+
+#endif
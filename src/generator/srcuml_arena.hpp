@@ -0,0 +1,138 @@
+/**
+ * @file srcuml_arena.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INCLUDED_SRCUML_ARENA_HPP
+#define INCLUDED_SRCUML_ARENA_HPP
+
+#include <vector>
+#include <memory>
+#include <new>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <cstdint>
+
+/**
+ * srcuml_arena
+ *
+ * Bump allocator that owns the model objects created in it.  Objects are
+ * placed one after another in blocks that grow geometrically, and are all
+ * destroyed and freed together with the arena.  An arena is used by one
+ * thread at a time.
+ */
+class srcuml_arena {
+
+private:
+
+    static const std::size_t MAX_BLOCK_SIZE = 1 << 20;
+
+    struct destructor {
+
+        void (*destroy)(void *);
+        void * object;
+
+    };
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char * current;
+    std::size_t remaining;
+    std::size_t next_block_size;
+    std::size_t allocated;
+
+    std::vector<destructor> destructors;
+
+public:
+
+    srcuml_arena(std::size_t initial_block_size = 4096)
+        : blocks(),
+          current(nullptr),
+          remaining(0),
+          next_block_size(initial_block_size),
+          allocated(0),
+          destructors() {}
+
+    ~srcuml_arena() {
+
+        for(std::vector<destructor>::reverse_iterator itr = destructors.rbegin(); itr != destructors.rend(); ++itr)
+            itr->destroy(itr->object);
+
+    }
+
+    srcuml_arena(const srcuml_arena &) = delete;
+    srcuml_arena & operator=(const srcuml_arena &) = delete;
+
+    void * allocate(std::size_t size, std::size_t alignment) {
+
+        std::size_t padding = padding_for(current, alignment);
+        if(!current || padding + size > remaining) {
+
+            std::size_t block_size = std::max(next_block_size, size + alignment);
+            next_block_size = std::min(next_block_size * 2, std::size_t(MAX_BLOCK_SIZE));
+
+            blocks.emplace_back(new char[block_size]);
+            current = blocks.back().get();
+            remaining = block_size;
+            allocated += block_size;
+
+            padding = padding_for(current, alignment);
+
+        }
+
+        void * memory = current + padding;
+        current += padding + size;
+        remaining -= padding + size;
+
+        return memory;
+
+    }
+
+    /** construct a T in the arena, it lives until the arena is destroyed */
+    template<typename T, typename... arguments>
+    T * create(arguments &&... args) {
+
+        T * object = new(allocate(sizeof(T), alignof(T))) T(std::forward<arguments>(args)...);
+        if(!std::is_trivially_destructible<T>::value)
+            destructors.push_back(destructor{ &destroy<T>, object });
+
+        return object;
+
+    }
+
+    /** bytes reserved from the heap */
+    std::size_t get_allocated() const {
+        return allocated;
+    }
+
+private:
+
+    static std::size_t padding_for(const char * pointer, std::size_t alignment) {
+        return (alignment - reinterpret_cast<std::uintptr_t>(pointer) % alignment) % alignment;
+    }
+
+    template<typename T>
+    static void destroy(void * object) {
+        static_cast<T *>(object)->~T();
+    }
+
+};
+
+#endif
@@ -31,7 +31,6 @@ class srcuml_attribute {
 
 private:
 
-    const DeclTypePolicy::DeclTypeData * data;
     const ClassPolicy::AccessSpecifier visibility;
 
     srcuml_type type;
@@ -42,12 +41,11 @@ private:
     bool is_static;
 
     bool has_index;
-    std::string index;
+    srcuml_symbol index;
 
 public:
     srcuml_attribute(const DeclTypePolicy::DeclTypeData * data, ClassPolicy::AccessSpecifier visibility)
-        : data(data),
-          visibility(visibility),
+        : visibility(visibility),
           type(data->type),
           name(data->name ? data->name->ToString() : ""),
           is_pointer(type.get_is_pointer()),
@@ -55,10 +53,35 @@ public:
           has_index(false),
           index() {
 
-            analyze_attribute();
+            analyze_attribute(data);
 
     }
 
+    srcuml_attribute(srcuml_binary_reader & reader)
+        : visibility((ClassPolicy::AccessSpecifier)reader.read_uint()),
+          type(reader),
+          name(reader.read_string()),
+          is_pointer(reader.read_bool()),
+          is_static(reader.read_bool()),
+          has_index(reader.read_bool()),
+          index(reader.read_string()) {}
+
+    void write(srcuml_binary_writer & writer) const {
+
+        writer.write_uint(visibility);
+        type.write(writer);
+        writer.write_string(name);
+        writer.write_bool(is_pointer);
+        writer.write_bool(is_static);
+        writer.write_bool(has_index);
+        writer.write_string(index.get_string());
+
+    }
+
+    ClassPolicy::AccessSpecifier get_visibility() const {
+        return visibility;
+    }
+
     const std::string & get_name() const {
         return name;
     }
@@ -78,7 +101,7 @@ public:
             std::string multiplicity = "［";
             if(is_pointer)
                 multiplicity += "0..";
-            multiplicity += index;
+            multiplicity += index.get_string();
             multiplicity += "］";
 
             return multiplicity;
@@ -99,10 +122,16 @@ public:
 
     }
 
-    // ~srcuml_attribute() { if(data) delete data; }
-
     friend std::ostream & operator<<(std::ostream & out, const srcuml_attribute & attribute) {
 
+        srcuml_output_buffer buffer(out);
+        buffer << attribute;
+        return out;
+
+    }
+
+    friend srcuml_output_buffer & operator<<(srcuml_output_buffer & out, const srcuml_attribute & attribute) {
+
         if(attribute.visibility == ClassPolicy::PUBLIC)
             out << '+';
         else if(attribute.visibility == ClassPolicy::PRIVATE)
@@ -125,16 +154,16 @@ public:
     }
 
 private:
-    void analyze_attribute() {
+    void analyze_attribute(const DeclTypePolicy::DeclTypeData * data) {
 
         if(!data->name) return;
 
         if(!data->name->arrayIndices.empty()) {
             has_index = true;
-            index = data->name->arrayIndices[0];
+            index = srcuml_symbol(data->name->arrayIndices[0]);
         } else if(type.get_has_index()) {
             has_index = true;
-            index = type.get_index();
+            index = type.get_index_symbol();
         }
 
     }
@@ -0,0 +1,158 @@
+/**
+ * @file srcuml_binary.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDED_SRCUML_BINARY_HPP
+#define INCLUDED_SRCUML_BINARY_HPP
+
+#include <string>
+#include <stdexcept>
+#include <cstdint>
+
+/**
+ * srcuml_binary_writer
+ *
+ * Appends model data to a buffer.  Integers are written as variable
+ * length (LEB128) and strings are length prefixed.
+ */
+class srcuml_binary_writer {
+
+private:
+
+    std::string & buffer;
+
+public:
+
+    srcuml_binary_writer(std::string & buffer)
+        : buffer(buffer) {}
+
+    void write_uint(std::uint64_t value) {
+
+        while(value >= 0x80) {
+            buffer += static_cast<char>((value & 0x7f) | 0x80);
+            value >>= 7;
+        }
+        buffer += static_cast<char>(value);
+
+    }
+
+    void write_bool(bool value) {
+        buffer += value ? '\1' : '\0';
+    }
+
+    void write_string(const std::string & value) {
+
+        write_uint(value.size());
+        buffer += value;
+
+    }
+
+    void write_raw(const char * data, std::size_t size) {
+        buffer.append(data, size);
+    }
+
+    std::size_t size() const {
+        return buffer.size();
+    }
+
+};
+
+/**
+ * srcuml_binary_reader
+ *
+ * Reads data written by srcuml_binary_writer from memory, e.g., a mapped
+ * file.  Reading past the end throws std::runtime_error.
+ */
+class srcuml_binary_reader {
+
+private:
+
+    const char * current;
+    const char * end;
+
+public:
+
+    srcuml_binary_reader(const char * data, std::size_t size)
+        : current(data),
+          end(data + size) {}
+
+    std::uint64_t read_uint() {
+
+        std::uint64_t value = 0;
+        for(unsigned int shift = 0; shift < 64; shift += 7) {
+
+            check(1);
+            unsigned char byte = *current++;
+            value |= std::uint64_t(byte & 0x7f) << shift;
+            if(!(byte & 0x80)) return value;
+
+        }
+
+        throw std::runtime_error("Invalid integer in binary data");
+
+    }
+
+    bool read_bool() {
+
+        check(1);
+        return *current++ != '\0';
+
+    }
+
+    std::string read_string() {
+
+        std::size_t size = read_uint();
+        check(size);
+
+        std::string value(current, size);
+        current += size;
+
+        return value;
+
+    }
+
+    /** advance over size bytes and return where they start */
+    const char * read_raw(std::size_t size) {
+
+        check(size);
+
+        const char * data = current;
+        current += size;
+
+        return data;
+
+    }
+
+    bool at_end() const {
+        return current == end;
+    }
+
+private:
+
+    void check(std::size_t size) const {
+
+        if(std::size_t(end - current) < size)
+            throw std::runtime_error("Unexpected end of binary data");
+
+    }
+
+};
+
+#endif
@@ -0,0 +1,215 @@
+/**
+ * @file srcuml_cache.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDED_SRCUML_CACHE_HPP
+#define INCLUDED_SRCUML_CACHE_HPP
+
+#include <srcuml_class.hpp>
+#include <srcuml_binary.hpp>
+#include <srcuml_arena.hpp>
+#include <srcuml_input.hpp>
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <fstream>
+#include <stdexcept>
+#include <cstdio>
+#include <cstdint>
+
+/**
+ * srcuml_cache
+ *
+ * On-disk cache of the classes found in each unit, keyed by the unit's
+ * filename and a hash of its content.  Units whose hash is unchanged are
+ * read back from the cache instead of being parsed again.
+ *
+ * The cache stores class summaries before relationships are analyzed.  A
+ * cache with a different version, one made with other parse settings
+ * (skipped bodies, filters), or one that cannot be read, is ignored and
+ * rebuilt.
+ */
+class srcuml_cache {
+
+public:
+
+    /** increment whenever the stored class summary changes */
+    static const std::uint64_t VERSION = 9;
+
+    struct unit {
+
+        std::string filename;
+        std::uint64_t hash;
+        const std::vector<srcuml_class *> * classes;
+
+    };
+
+private:
+
+    struct entry {
+
+        std::uint64_t hash;
+        const char * data;
+        std::size_t size;
+
+    };
+
+    std::string filename;
+    std::string settings;
+
+    std::unique_ptr<srcuml_input> input;
+    std::unordered_map<std::string, entry> entries;
+
+public:
+
+    srcuml_cache(const std::string & filename, const std::string & settings)
+        : filename(filename),
+          settings(settings),
+          input(),
+          entries() {
+
+            open();
+
+    }
+
+    /**
+     * Add the cached classes of a unit, created in the arena.  Returns false
+     * if the unit is not cached or has changed.  Safe to call from several
+     * threads with different arenas.
+     */
+    bool load(const std::string & unit_filename, std::uint64_t hash, srcuml_arena & arena, std::vector<srcuml_class *> & classes) const {
+
+        std::unordered_map<std::string, entry>::const_iterator citr = entries.find(unit_filename);
+        if(citr == entries.end() || citr->second.hash != hash) return false;
+
+        std::vector<srcuml_class *> cached_classes;
+        try {
+
+            srcuml_binary_reader reader(citr->second.data, citr->second.size);
+            for(std::size_t count = reader.read_uint(); count > 0; --count)
+                cached_classes.push_back(arena.create<srcuml_class>(reader));
+
+        } catch(const std::runtime_error &) {
+
+            return false;
+
+        }
+
+        classes.insert(classes.end(), cached_classes.begin(), cached_classes.end());
+        return true;
+
+    }
+
+    /** replace the cache with the given units */
+    void save(const std::vector<unit> & units) const {
+
+        std::string buffer;
+        srcuml_binary_writer writer(buffer);
+
+        writer.write_raw(magic(), 8);
+        writer.write_uint(VERSION);
+        writer.write_string(settings);
+
+        std::size_t count = 0;
+        for(const unit & the_unit : units)
+            if(!the_unit.filename.empty()) ++count;
+        writer.write_uint(count);
+
+        std::string unit_buffer;
+        for(const unit & the_unit : units) {
+
+            if(the_unit.filename.empty()) continue;
+
+            unit_buffer.clear();
+            srcuml_binary_writer unit_writer(unit_buffer);
+            unit_writer.write_uint(the_unit.classes->size());
+            for(const srcuml_class * aclass : *the_unit.classes)
+                aclass->write(unit_writer);
+
+            writer.write_string(the_unit.filename);
+            writer.write_uint(the_unit.hash);
+            writer.write_string(unit_buffer);
+
+        }
+
+        // write a new file and rename it, the old one may still be mapped
+        std::string temporary = filename + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            out.write(buffer.data(), buffer.size());
+            if(!out)
+                throw std::runtime_error("Unable to write cache file: " + temporary);
+        }
+
+        if(std::rename(temporary.c_str(), filename.c_str()) != 0)
+            throw std::runtime_error("Unable to write cache file: " + filename);
+
+    }
+
+private:
+
+    static const char * magic() {
+        return "srcUMLc\n";
+    }
+
+    void open() {
+
+        std::ifstream exists(filename);
+        if(!exists) return;
+        exists.close();
+
+        try {
+
+            input.reset(new srcuml_input(filename.c_str()));
+
+            srcuml_binary_reader reader(input->get_data(), input->get_size());
+            if(std::string(reader.read_raw(8), 8) != magic() || reader.read_uint() != VERSION
+                || reader.read_string() != settings) {
+
+                input.reset();
+                return;
+
+            }
+
+            for(std::size_t count = reader.read_uint(); count > 0; --count) {
+
+                std::string unit_filename = reader.read_string();
+                std::uint64_t hash = reader.read_uint();
+                std::size_t size = reader.read_uint();
+                const char * data = reader.read_raw(size);
+
+                entries[unit_filename] = entry{ hash, data, size };
+
+            }
+
+        } catch(const std::runtime_error &) {
+
+            entries.clear();
+            input.reset();
+
+        }
+
+    }
+
+};
+
+#endif
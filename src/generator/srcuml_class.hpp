@@ -26,17 +26,32 @@
 
 #include <srcuml_attribute.hpp>
 #include <srcuml_operation.hpp>
+#include <srcuml_signature_set.hpp>
 #include <static_outputter.hpp>
 
+#include <srcuml_binary.hpp>
+#include <srcuml_symbol.hpp>
+
+#include <array>
 #include <map>
 #include <set>
 
+/**
+ * srcuml_class
+ *
+ * Summary of a class.  All needed information is extracted from the
+ * policy data on construction, so the ClassData may be freed immediately.
+ */
 class srcuml_class {
 
 private:
-    const ClassPolicy::ClassData * data;
+    srcuml_symbol name;
+    std::vector<srcuml_symbol> parents;
 
-    std::string name;
+    /** enclosing namespace, class, and the using directives in effect, used to resolve names */
+    srcuml_symbol namespace_name;
+    srcuml_symbol enclosing_class;
+    std::vector<srcuml_symbol> using_namespaces;
 
     bool has_field;
     bool has_constructor;
@@ -47,7 +62,6 @@ private:
     // handle if pure virtual destructor
     bool has_destructor;
     bool has_public_assignment;
-    const FunctionPolicy::FunctionData * assignment;
 
     bool has_operator;
     bool has_method;
@@ -58,14 +72,21 @@ private:
 
     bool is_finalized;
 
-    std::map<std::string, const FunctionPolicy::FunctionData *> implemented_functions_map;
-    std::map<std::string, const FunctionPolicy::FunctionData *> pure_virtual_functions_map;
+    srcuml_signature_set implemented_functions;
+    srcuml_signature_set pure_virtual_functions;
 
     std::vector<srcuml_attribute> attributes;
+    std::vector<srcuml_operation> operations;
+    std::vector<srcuml_operation> operators;
 
 public:
-    srcuml_class(const ClassPolicy::ClassData * data)
-        : data(data),
+    srcuml_class(const ClassPolicy::ClassData * data,
+                 const std::string & namespace_name = std::string(),
+                 const std::string & enclosing_class = std::string(),
+                 const std::vector<std::string> & using_namespaces = std::vector<std::string>(),
+                 srcuml_member_qualifiers * member_qualifiers = nullptr)
+        : namespace_name(namespace_name),
+          enclosing_class(enclosing_class),
           has_field(false),
           has_constructor(false),
           has_default_constructor(false),
@@ -74,7 +95,6 @@ public:
           has_copy_constructor(false),
           has_destructor(false),
           has_public_assignment(false),
-          assignment(nullptr),
           has_operator(false),
           has_method(false),
           is_interface(false),
@@ -82,38 +102,118 @@ public:
           is_datatype(false),
           is_finalized(false) {
 
-            analyze_data();
+            for(const std::string & using_namespace : using_namespaces)
+                this->using_namespaces.emplace_back(using_namespace);
+
+            analyze_data(data, member_qualifiers);
 
     }
 
-    ~srcuml_class() { if(data) delete data; }
+    srcuml_class(srcuml_binary_reader & reader)
+        : name(reader.read_string()) {
+
+            for(std::size_t count = reader.read_uint(); count > 0; --count)
+                parents.emplace_back(reader.read_string());
+
+            namespace_name = srcuml_symbol(reader.read_string());
+            enclosing_class = srcuml_symbol(reader.read_string());
+            for(std::size_t count = reader.read_uint(); count > 0; --count)
+                using_namespaces.emplace_back(reader.read_string());
+
+            for(bool srcuml_class::* flag : flag_members())
+                this->*flag = reader.read_bool();
 
-    const ClassPolicy::ClassData & get_data() const {
+            for(std::size_t count = reader.read_uint(); count > 0; --count)
+                attributes.emplace_back(reader);
 
-        return *data;
+            for(std::size_t count = reader.read_uint(); count > 0; --count)
+                operations.emplace_back(reader);
+
+            for(std::size_t count = reader.read_uint(); count > 0; --count)
+                operators.emplace_back(reader);
+
+            map_functions();
 
     }
 
+    /**
+     * Write the summary along with the interface and abstract flags as
+     * they are when called.  The cache writes classes as parsed, before
+     * relationships are analyzed, and the model writes them after, so a
+     * loaded model keeps the flags inheritance resolved.
+     */
+    void write(srcuml_binary_writer & writer) const {
+
+        writer.write_string(name.get_string());
+
+        writer.write_uint(parents.size());
+        for(const srcuml_symbol & parent : parents)
+            writer.write_string(parent.get_string());
+
+        writer.write_string(namespace_name.get_string());
+        writer.write_string(enclosing_class.get_string());
+        writer.write_uint(using_namespaces.size());
+        for(const srcuml_symbol & using_namespace : using_namespaces)
+            writer.write_string(using_namespace.get_string());
+
+        for(bool srcuml_class::* flag : flag_members())
+            writer.write_bool(this->*flag);
+
+        writer.write_uint(attributes.size());
+        for(const srcuml_attribute & attribute : attributes)
+            attribute.write(writer);
+
+        writer.write_uint(operations.size());
+        for(const srcuml_operation & operation : operations)
+            operation.write(writer);
+
+        writer.write_uint(operators.size());
+        for(const srcuml_operation & op : operators)
+            op.write(writer);
+
+    }
+
+    srcuml_class(const srcuml_class &) = delete;
+    srcuml_class & operator=(const srcuml_class &) = delete;
+
 
     const std::string & get_name() const {
 
+        return name.get_string();
+
+    }
+
+    srcuml_symbol get_name_symbol() const {
         return name;
+    }
+
+    /** qualified name of the enclosing namespace, empty for the global namespace */
+    srcuml_symbol get_namespace_symbol() const {
+        return namespace_name;
+    }
+
+    /** qualified name of the class it is nested in, within its namespace, empty if not nested */
+    srcuml_symbol get_enclosing_class_symbol() const {
+        return enclosing_class;
+    }
 
+    const std::vector<srcuml_symbol> & get_using_namespaces() const {
+        return using_namespaces;
     }
 
     std::string get_srcuml_name() const {
 
         if(is_interface)
-            return "«interface»\\n" + name;
+            return "«interface»\\n" + name.get_string();
 
         // not sure if should be gulliments or {}
         if(is_abstract)
-            return " ｛abstract｝\\n" + name;
+            return " ｛abstract｝\\n" + name.get_string();
 
         if(is_datatype)
-            return "«datatype»\\n" + name;
+            return "«datatype»\\n" + name.get_string();
 
-        return name;
+        return name.get_string();
 
     }
 
@@ -133,6 +233,10 @@ public:
         this->is_abstract = is_abstract;
     }
 
+    bool get_is_datatype() const {
+        return is_datatype;
+    }
+
     bool get_is_finalized() const {
         return is_finalized;
     }
@@ -149,31 +253,64 @@ public:
     	return has_field;
     }
 
-    const std::map<std::string, const FunctionPolicy::FunctionData *> & get_implemented_functions_map() const {
-        return implemented_functions_map;
+    const std::vector<srcuml_symbol> & get_parents() const {
+        return parents;
+    }
+
+    const srcuml_signature_set & get_implemented_functions() const {
+        return implemented_functions;
     }
 
-    std::map<std::string, const FunctionPolicy::FunctionData *> & get_pure_virtual_functions_map() {
-        return pure_virtual_functions_map;
+    /** the class's own pure virtual functions, inherited ones are tracked by srcuml_relationships */
+    const srcuml_signature_set & get_pure_virtual_functions() const {
+        return pure_virtual_functions;
     }
 
     const std::vector<srcuml_attribute> & get_attributes() const {
         return attributes;
     } 
 
+    /** methods in access order, operators are not included */
+    const std::vector<srcuml_operation> & get_operations() const {
+        return operations;
+    }
+
 private:
 
-    void analyze_data() {
+    static const std::array<bool srcuml_class::*, 14> & flag_members() {
+
+        static const std::array<bool srcuml_class::*, 14> members = {{
+            &srcuml_class::has_field,
+            &srcuml_class::has_constructor,
+            &srcuml_class::has_default_constructor, &srcuml_class::has_public_default_constructor,
+            &srcuml_class::has_copy_constructor, &srcuml_class::has_public_copy_constructor,
+            &srcuml_class::has_destructor,
+            &srcuml_class::has_public_assignment,
+            &srcuml_class::has_operator, &srcuml_class::has_method,
+            &srcuml_class::is_interface, &srcuml_class::is_abstract, &srcuml_class::is_datatype,
+            &srcuml_class::is_finalized
+        }};
 
-        name = data->name->SimpleName();
+        return members;
+
+    }
+
+    void analyze_data(const ClassPolicy::ClassData * data, srcuml_member_qualifiers * member_qualifiers) {
+
+        name = srcuml_symbol(data->name->SimpleName());
         // if(data->isGeneric) name += "<>";
 
+        for(const ClassPolicy::ParentData & parent_data : data->parents)
+            parents.emplace_back(parent_data.name);
+
         has_field = data->fields[ClassPolicy::PUBLIC].size() || data->fields[ClassPolicy::PRIVATE].size() || data->fields[ClassPolicy::PROTECTED].size();
         has_constructor = data->constructors[ClassPolicy::PUBLIC].size() || data->constructors[ClassPolicy::PRIVATE].size() || data->constructors[ClassPolicy::PROTECTED].size();
         has_destructor = data->hasDestructor;
         has_method = data->operators[ClassPolicy::PUBLIC].size() || data->operators[ClassPolicy::PRIVATE].size() || data->operators[ClassPolicy::PROTECTED].size();
         has_method = data->methods[ClassPolicy::PUBLIC].size() || data->methods[ClassPolicy::PRIVATE].size() || data->methods[ClassPolicy::PROTECTED].size();
 
+        const FunctionPolicy::FunctionData * assignment = nullptr;
+
         bool no_private_or_protected_methods
             = data->operators[ClassPolicy::PRIVATE].empty() && data->operators[ClassPolicy::PROTECTED].empty()
              && data->methods[ClassPolicy::PRIVATE].empty() && data->methods[ClassPolicy::PROTECTED].empty();
@@ -195,7 +332,7 @@ private:
 
                     for(const std::pair<void *, TypePolicy::TypeType> & p_type : constructor->parameters.back()->type->types) {
 
-                        if(p_type.second == TypePolicy::NAME && name == static_cast<NamePolicy::NameData *>(p_type.first)->SimpleName()) {
+                        if(p_type.second == TypePolicy::NAME && name.get_string() == static_cast<NamePolicy::NameData *>(p_type.first)->SimpleName()) {
 
                             has_copy_constructor = true;
                             if(access == ClassPolicy::PUBLIC)
@@ -267,18 +404,35 @@ private:
 
         for(std::size_t access = 0; access <= ClassPolicy::PROTECTED; ++access) {
 
-            for(const FunctionPolicy::FunctionData * method : data->methods[access]) {
-                if(method->isPureVirtual)
-                    pure_virtual_functions_map[method->ToString()] = method;
-                else
-                    implemented_functions_map[method->ToString()] = method;
-            }
+            for(const FunctionPolicy::FunctionData * method : data->methods[access])
+                operations.emplace_back(method, (ClassPolicy::AccessSpecifier)access, take_qualifiers(member_qualifiers, access, method));
 
-            for(const FunctionPolicy::FunctionData * op : data->operators[access]) {
-               if(op->isPureVirtual)
-                    pure_virtual_functions_map[op->ToString()] = op;
+            for(const FunctionPolicy::FunctionData * op : data->operators[access])
+                operators.emplace_back(op, (ClassPolicy::AccessSpecifier)access, take_qualifiers(member_qualifiers, access, op));
+
+        }
+
+        map_functions();
+
+    }
+
+    static std::uint32_t take_qualifiers(srcuml_member_qualifiers * member_qualifiers, std::size_t access, const FunctionPolicy::FunctionData * function) {
+
+        if(!member_qualifiers) return srcuml_member_qualifiers::NO_QUALIFIER;
+        return member_qualifiers->take((ClassPolicy::AccessSpecifier)access, function->name->ToString());
+
+    }
+
+    void map_functions() {
+
+        // operations are complete, so pointers into them are stable
+        for(const std::vector<srcuml_operation> * functions : { &operations, &operators }) {
+
+            for(const srcuml_operation & function : *functions) {
+                if(function.get_is_pure_virtual())
+                    pure_virtual_functions.insert(&function);
                 else
-                    implemented_functions_map[op->ToString()] = op;
+                    implemented_functions.insert(&function);
             }
 
         }
@@ -0,0 +1,262 @@
+/**
+ * @file srcuml_class_index.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INCLUDED_SRCUML_CLASS_INDEX_HPP
+#define INCLUDED_SRCUML_CLASS_INDEX_HPP
+
+#include <srcuml_class.hpp>
+#include <srcuml_symbol.hpp>
+
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+/**
+ * srcuml_class_index
+ *
+ * Resolves type names to classes the way C++ name lookup does: through the
+ * class itself and its enclosing classes and namespaces from the innermost
+ * out, then the using directives in effect, so classes with the same
+ * simple name in different namespaces or classes are told apart.
+ *
+ * Namespaces and classes form a trie of scopes whose nodes are ids, 0
+ * being the global namespace, and every class has a scope of its own
+ * that its nested classes are indexed under.  Every relative spelling of
+ * a scope is hashed together with the scope it is relative to, e.g.,
+ * Outer in Outer::Inner names the scope of the class Outer.  A class is
+ * found by hashing its enclosing scope id with its name, so each step of
+ * a lookup is a single probe.
+ */
+class srcuml_class_index {
+
+public:
+
+    enum : std::uint32_t { NO_CLASS = 0xffffffff };
+
+private:
+
+    enum : std::uint32_t { AMBIGUOUS = NO_CLASS - 1, GLOBAL = 0 };
+
+    /** parent and last name part of each scope, the global namespace is its own parent */
+    std::vector<std::uint32_t> scope_parents;
+    std::vector<srcuml_symbol> scope_parts;
+
+    /** (scope, relative qualified name) to the namespace or class scope it names */
+    std::unordered_map<std::uint64_t, std::uint32_t> scopes;
+
+    /** (enclosing scope, simple name) to class */
+    std::unordered_map<std::uint64_t, std::uint32_t> qualified_classes;
+
+    /** simple name to class, AMBIGUOUS if several classes share it */
+    std::unordered_map<srcuml_symbol, std::uint32_t> simple_classes;
+
+    /** scope enclosing each class and the class's own scope */
+    std::vector<std::uint32_t> class_enclosing_scopes;
+    std::vector<std::uint32_t> class_scopes;
+    std::vector<std::vector<std::uint32_t>> class_usings;
+
+public:
+
+    srcuml_class_index(const std::vector<srcuml_class *> & classes)
+        : scope_parents(1, GLOBAL),
+          scope_parts(1, srcuml_symbol()) {
+
+            class_enclosing_scopes.reserve(classes.size());
+            class_scopes.reserve(classes.size());
+            for(std::uint32_t node = 0; node < classes.size(); ++node) {
+
+                const srcuml_class * aclass = classes[node];
+                std::uint32_t enclosing_id = add_scope(add_scope(GLOBAL, aclass->get_namespace_symbol()), aclass->get_enclosing_class_symbol());
+                class_enclosing_scopes.push_back(enclosing_id);
+                class_scopes.push_back(add_scope(enclosing_id, aclass->get_name_symbol()));
+
+                // a later class with the same qualified name replaces the earlier
+                qualified_classes[make_key(enclosing_id, aclass->get_name_symbol())] = node;
+
+                std::pair<std::unordered_map<srcuml_symbol, std::uint32_t>::iterator, bool> simple
+                    = simple_classes.emplace(aclass->get_name_symbol(), node);
+                if(!simple.second && simple.first->second != AMBIGUOUS)
+                    simple.first->second = class_enclosing_scopes[simple.first->second] == enclosing_id ? node : AMBIGUOUS;
+
+            }
+
+            class_usings.resize(classes.size());
+            for(std::uint32_t node = 0; node < classes.size(); ++node) {
+
+                for(const srcuml_symbol & using_namespace : classes[node]->get_using_namespaces()) {
+
+                    std::uint32_t namespace_id = find_scope(class_enclosing_scopes[node], using_namespace);
+                    if(namespace_id != NO_CLASS)
+                        class_usings[node].push_back(namespace_id);
+
+                }
+
+            }
+
+    }
+
+    /**
+     * Class named by name, written with qualifier (empty if none), as seen
+     * from inside class context.  NO_CLASS if there is none.
+     */
+    std::uint32_t resolve(std::uint32_t context, srcuml_symbol qualifier, srcuml_symbol name) const {
+
+        for(std::uint32_t scope = class_scopes[context];; scope = scope_parents[scope]) {
+
+            std::uint32_t found = find_in(scope, qualifier, name);
+            if(found != NO_CLASS) return found;
+
+            if(scope == GLOBAL) break;
+
+        }
+
+        for(std::uint32_t using_namespace : class_usings[context]) {
+
+            std::uint32_t found = find_in(using_namespace, qualifier, name);
+            if(found != NO_CLASS) return found;
+
+        }
+
+        // declarations the parse did not see, a unique simple name is unambiguous
+        if(!qualifier.empty()) return NO_CLASS;
+
+        std::unordered_map<srcuml_symbol, std::uint32_t>::const_iterator simple = simple_classes.find(name);
+        if(simple == simple_classes.end() || simple->second == AMBIGUOUS) return NO_CLASS;
+
+        return simple->second;
+
+    }
+
+    /** resolve a name as written, e.g., a parent name such as base::Node */
+    std::uint32_t resolve(std::uint32_t context, const std::string & name) const {
+
+        std::string::size_type separator = name.rfind("::");
+        if(separator == std::string::npos)
+            return resolve(context, srcuml_symbol(), srcuml_symbol(name));
+
+        std::string::size_type qualifier_begin = name.compare(0, 2, "::") == 0 ? 2 : 0;
+        return resolve(context,
+                       srcuml_symbol(separator > qualifier_begin ? name.substr(qualifier_begin, separator - qualifier_begin) : std::string()),
+                       srcuml_symbol(name.substr(separator + 2)));
+
+    }
+
+private:
+
+    static std::uint64_t make_key(std::uint32_t scope, srcuml_symbol name) {
+        return (std::uint64_t(scope) << 32) | name.get_id();
+    }
+
+    std::uint32_t find_scope(std::uint32_t scope, srcuml_symbol name) const {
+
+        for(;; scope = scope_parents[scope]) {
+
+            std::unordered_map<std::uint64_t, std::uint32_t>::const_iterator found = scopes.find(make_key(scope, name));
+            if(found != scopes.end()) return found->second;
+
+            if(scope == GLOBAL) return NO_CLASS;
+
+        }
+
+    }
+
+    std::uint32_t find_in(std::uint32_t scope, srcuml_symbol qualifier, srcuml_symbol name) const {
+
+        if(!qualifier.empty()) {
+
+            std::unordered_map<std::uint64_t, std::uint32_t>::const_iterator found = scopes.find(make_key(scope, qualifier));
+            if(found == scopes.end()) return NO_CLASS;
+
+            scope = found->second;
+
+        }
+
+        std::unordered_map<std::uint64_t, std::uint32_t>::const_iterator found = qualified_classes.find(make_key(scope, name));
+        return found != qualified_classes.end() ? found->second : NO_CLASS;
+
+    }
+
+    static std::vector<std::string> split(const std::string & qualified_name) {
+
+        std::vector<std::string> parts;
+        for(std::string::size_type begin = 0; begin <= qualified_name.size();) {
+
+            std::string::size_type end = qualified_name.find("::", begin);
+            if(end == std::string::npos) end = qualified_name.size();
+
+            if(end > begin)
+                parts.push_back(qualified_name.substr(begin, end - begin));
+
+            begin = end + 2;
+
+        }
+
+        return parts;
+
+    }
+
+    /** scope id of a qualified name relative to scope, adding it and its parents if new */
+    std::uint32_t add_scope(std::uint32_t scope, srcuml_symbol qualified_name) {
+
+        if(qualified_name.empty()) return scope;
+
+        std::unordered_map<std::uint64_t, std::uint32_t>::const_iterator known = scopes.find(make_key(scope, qualified_name));
+        if(known != scopes.end()) return known->second;
+
+        for(const std::string & part : split(qualified_name.get_string())) {
+
+            srcuml_symbol part_symbol(part);
+            std::unordered_map<std::uint64_t, std::uint32_t>::const_iterator child = scopes.find(make_key(scope, part_symbol));
+            if(child != scopes.end()) {
+
+                scope = child->second;
+                continue;
+
+            }
+
+            std::uint32_t scope_id = scope_parents.size();
+            scope_parents.push_back(scope);
+            scope_parts.push_back(part_symbol);
+
+            // every ancestor can reach the new scope by its relative name
+            std::string relative_name = part;
+            for(std::uint32_t ancestor = scope;; ancestor = scope_parents[ancestor]) {
+
+                scopes.emplace(make_key(ancestor, srcuml_symbol(relative_name)), scope_id);
+                if(ancestor == GLOBAL) break;
+
+                relative_name = scope_parts[ancestor].get_string() + "::" + relative_name;
+
+            }
+
+            scope = scope_id;
+
+        }
+
+        return scope;
+
+    }
+
+};
+
+#endif
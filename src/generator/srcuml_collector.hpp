@@ -0,0 +1,104 @@
+/**
+ * @file srcuml_collector.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDED_SRCUML_COLLECTOR_HPP
+#define INCLUDED_SRCUML_COLLECTOR_HPP
+
+#include <srcSAXEventDispatchUtilities.hpp>
+#include <srcSAXController.hpp>
+
+#include <srcuml_dispatcher.hpp>
+#include <ClassPolicySingleEvent.hpp>
+
+#include <srcuml_filter.hpp>
+#include <srcuml_arena.hpp>
+#include <srcuml_class.hpp>
+
+#include <memory>
+#include <vector>
+
+/**
+ * srcuml_collector
+ *
+ * Listens to a parse and appends a srcuml_class, created in the arena,
+ * for every class found that passes the filter.  A collector and its dispatcher are used by a single thread, so
+ * concurrent parses each use their own.
+ */
+class srcuml_collector : public srcSAXEventDispatch::PolicyListener {
+
+private:
+
+    srcuml_arena & arena;
+    std::vector<srcuml_class *> & classes;
+
+    const srcuml_filter & filter;
+    srcuml_dispatcher<ClassPolicy> * dispatcher;
+
+public:
+
+    srcuml_collector(srcuml_arena & arena, std::vector<srcuml_class *> & classes, const srcuml_filter & filter)
+        : arena(arena),
+          classes(classes),
+          filter(filter),
+          dispatcher(nullptr) {}
+
+    void parse(srcSAXController & controller) {
+
+        srcuml_dispatcher<ClassPolicy> dispatcher(this, &filter);
+        this->dispatcher = &dispatcher;
+        controller.parse(&dispatcher);
+        this->dispatcher = nullptr;
+
+    }
+
+    virtual void Notify(const srcSAXEventDispatch::PolicyDispatcher * policy, const srcSAXEventDispatch::srcSAXEventContext & ctx) override {
+
+        if(typeid(ClassPolicy) == typeid(*policy)) {
+
+            // srcuml_class keeps only a summary, policy data is released at once
+            ClassPolicy::ClassData * class_data = policy->Data<ClassPolicy::ClassData>();
+            if(class_data && class_data->name && is_included(class_data->name->SimpleName())) {
+
+                if(dispatcher)
+                    classes.push_back(arena.create<srcuml_class>(class_data, dispatcher->get_namespace(), dispatcher->get_enclosing_class(), dispatcher->get_using_namespaces(),
+                                                                    &dispatcher->get_member_qualifiers()));
+                else
+                    classes.push_back(arena.create<srcuml_class>(class_data));
+
+            }
+            delete class_data;
+
+        }
+
+    }
+
+private:
+
+    bool is_included(const std::string & name) const {
+
+        std::string namespace_name = dispatcher ? dispatcher->get_namespace() : std::string();
+        return filter.is_class_included(namespace_name.empty() ? name : namespace_name + "::" + name);
+
+    }
+
+};
+
+#endif
@@ -24,19 +24,406 @@
 
 #include <srcSAXSingleEventDispatcher.hpp>
 
+#include <srcuml_filter.hpp>
+#include <srcuml_member_qualifiers.hpp>
+#include <srcuml_utilities.hpp>
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * srcuml_dispatcher
+ *
+ * Dispatches only the events srcUML needs and keeps track of the
+ * enclosing namespaces, the using directives in them, the enclosing
+ * classes of a nested class, and the qualifiers of member functions that
+ * the function policy does not keep.  The block of a namespace the filter rejects
+ * is not passed on, so nothing inside it is dispatched.  Using directives
+ * are file scoped, so they are dropped at every unit boundary and a whole
+ * archive is resolved the same as its units parsed one at a time.
+ */
 template <typename ...policies>
 class srcuml_dispatcher : public srcSAXEventDispatch::srcSAXSingleEventDispatcher<policies...> {
 
 private:
+
+    typedef srcSAXEventDispatch::srcSAXSingleEventDispatcher<policies...> base;
+
+    struct scope {
+
+        std::size_t depth;
+        std::string name;
+        std::vector<std::string> usings;
+
+    };
+
+    /** member function being read, its qualifiers follow the parameter list */
+    struct member_function {
+
+        std::size_t depth;
+        std::string name;
+        bool named;
+        bool after_parameters;
+        std::size_t qualifier_depth;
+        std::string qualifier;
+        std::uint32_t qualifiers;
+
+    };
+
+    struct class_scope {
+
+        std::size_t depth;
+        std::string name;
+        bool named;
+        std::size_t block_depth;
+        ClassPolicy::AccessSpecifier access;
+        member_function function;
+        srcuml_member_qualifiers members;
+
+    };
+
     bool dispatched;
 
+    const srcuml_filter * filter;
+
+    std::size_t depth;
+    std::size_t using_depth;
+    std::vector<scope> scopes;
+
+    /** using directives outside of any namespace */
+    std::vector<std::string> global_usings;
+
+    /** namespace named by the using directive being read */
+    std::size_t using_namespace_depth;
+    std::string using_name;
+
+    /** name of the namespace being started, until its block */
+    std::size_t name_depth;
+    std::string namespace_name;
+
+    /** classes being read in the innermost namespace, outermost first */
+    std::vector<class_scope> class_scopes;
+
+    /** member functions of the class last ended, which is the one dispatched */
+    srcuml_member_qualifiers member_qualifiers;
+
+    std::size_t skip_depth;
+
 public:
 
-   srcuml_dispatcher(srcSAXEventDispatch::PolicyListener * listener)
-        : srcSAXEventDispatch::srcSAXSingleEventDispatcher<policies...>(listener) {
+   srcuml_dispatcher(srcSAXEventDispatch::PolicyListener * listener, const srcuml_filter * filter = nullptr)
+        : srcSAXEventDispatch::srcSAXSingleEventDispatcher<policies...>(listener),
+          dispatched(false),
+          filter(filter),
+          depth(0),
+          using_depth(0),
+          scopes(),
+          global_usings(),
+          using_namespace_depth(0),
+          using_name(),
+          name_depth(0),
+          namespace_name(),
+          class_scopes(),
+          member_qualifiers(),
+          skip_depth(0) {
        srcSAXEventDispatch::srcSAXEventDispatcher<policies...>::RemoveEvents({"if", "for", "while", "typedef", "call", "macro", "init", "expr_stmt", "member_list" });
    }
 
+    /** qualified name of the enclosing namespace, empty in the global namespace */
+    std::string get_namespace() const {
+
+        return scopes.empty() ? std::string() : scopes.back().name;
+
+    }
+
+    /** qualified name of the enclosing class within its namespace, empty if not nested */
+    std::string get_enclosing_class() const {
+
+        std::string enclosing;
+        for(const class_scope & aclass : class_scopes) {
+
+            if(aclass.name.empty()) continue;
+            enclosing = enclosing.empty() ? aclass.name : enclosing + "::" + aclass.name;
+
+        }
+
+        return enclosing;
+
+    }
+
+    /** namespaces named by the using directives of the enclosing namespaces, outermost first */
+    std::vector<std::string> get_using_namespaces() const {
+
+        std::vector<std::string> usings(global_usings);
+        for(const scope & enclosing : scopes)
+            usings.insert(usings.end(), enclosing.usings.begin(), enclosing.usings.end());
+
+        return usings;
+
+    }
+
+    /** qualifiers of the member functions of the class being dispatched */
+    srcuml_member_qualifiers & get_member_qualifiers() {
+
+        return member_qualifiers;
+
+    }
+
+    virtual void startElement(const char * localname, const char * prefix, const char * URI,
+                              int num_namespaces, const struct srcsax_namespace * namespaces,
+                              int num_attributes, const struct srcsax_attribute * attributes) override {
+
+        ++depth;
+        if(skip_depth) return;
+
+        if(std::strcmp(localname, "unit") == 0) {
+
+            reset_unit();
+
+        } else if(std::strcmp(localname, "using") == 0) {
+
+            using_depth = depth;
+
+        } else if(std::strcmp(localname, "namespace") == 0 && using_depth == depth - 1) {
+
+            using_namespace_depth = depth;
+            using_name.clear();
+
+        } else if(using_namespace_depth == depth - 1 && std::strcmp(localname, "name") == 0 && !name_depth) {
+
+            name_depth = depth;
+
+        } else if(std::strcmp(localname, "namespace") == 0) {
+
+            // named once its <name> is read, a using directive is not a namespace
+            scopes.push_back(scope{ depth, get_namespace(), std::vector<std::string>() });
+            namespace_name.clear();
+
+        } else if(is_namespace_child() && std::strcmp(localname, "name") == 0 && !name_depth && namespace_name.empty()) {
+
+            name_depth = depth;
+
+        } else if(std::strcmp(localname, "class") == 0 || std::strcmp(localname, "struct") == 0) {
+
+            class_scopes.push_back(class_scope{ depth, std::string(), false, 0, ClassPolicy::PRIVATE, member_function(), srcuml_member_qualifiers() });
+
+        } else if(is_class_child() && std::strcmp(localname, "name") == 0 && !name_depth && !class_scopes.back().named) {
+
+            // only the first name of the class, without any template arguments
+            name_depth = depth;
+            class_scopes.back().named = true;
+
+        } else if(is_class_child() && std::strcmp(localname, "block") == 0 && !class_scopes.back().block_depth) {
+
+            class_scopes.back().block_depth = depth;
+
+        } else if(is_region_child()) {
+
+            if(std::strcmp(localname, "public") == 0)
+                class_scopes.back().access = ClassPolicy::PUBLIC;
+            else if(std::strcmp(localname, "private") == 0)
+                class_scopes.back().access = ClassPolicy::PRIVATE;
+            else if(std::strcmp(localname, "protected") == 0)
+                class_scopes.back().access = ClassPolicy::PROTECTED;
+
+        } else if(is_member_child() && (std::strcmp(localname, "function") == 0 || std::strcmp(localname, "function_decl") == 0)) {
+
+            class_scopes.back().function = member_function{ depth, std::string(), false, false, 0, std::string(), srcuml_member_qualifiers::NO_QUALIFIER };
+
+        } else if(is_function_child() && std::strcmp(localname, "name") == 0 && !name_depth && !class_scopes.back().function.named) {
+
+            name_depth = depth;
+            class_scopes.back().function.named = true;
+
+        } else if(is_function_child() && class_scopes.back().function.after_parameters
+                  && (std::strcmp(localname, "specifier") == 0 || std::strcmp(localname, "ref_qualifier") == 0 || std::strcmp(localname, "modifier") == 0)) {
+
+            class_scopes.back().function.qualifier_depth = depth;
+            class_scopes.back().function.qualifier.clear();
+
+        } else if(is_namespace_child() && std::strcmp(localname, "block") == 0) {
+
+            srcuml::trim(namespace_name);
+            if(!namespace_name.empty()) {
+
+                scope & current = scopes.back();
+                current.name = current.name.empty() ? namespace_name : current.name + "::" + namespace_name;
+
+            }
+
+            if(filter && !namespace_name.empty() && !filter->is_namespace_included(scopes.back().name)) {
+
+                skip_depth = depth;
+                return;
+
+            }
+
+        }
+
+        base::startElement(localname, prefix, URI, num_namespaces, namespaces, num_attributes, attributes);
+
+    }
+
+    virtual void endElement(const char * localname, const char * prefix, const char * URI) override {
+
+        std::size_t element_depth = depth--;
+        if(skip_depth) {
+
+            if(element_depth == skip_depth) skip_depth = 0;
+            return;
+
+        }
+
+        if(std::strcmp(localname, "unit") == 0)
+            reset_unit();
+        else if(element_depth == name_depth)
+            end_name();
+        else if(element_depth == using_depth)
+            end_using();
+        else if(!class_scopes.empty() && class_scopes.back().function.depth) {
+
+            member_function & function = class_scopes.back().function;
+            if(element_depth == function.qualifier_depth)
+                end_qualifier();
+            else if(element_depth == function.depth + 1 && std::strcmp(localname, "parameter_list") == 0)
+                function.after_parameters = true;
+            else if(element_depth == function.depth)
+                end_function();
+
+        }
+        else if(!class_scopes.empty() && class_scopes.back().depth == element_depth)
+            end_class();
+        else if(!scopes.empty() && scopes.back().depth == element_depth)
+            scopes.pop_back();
+
+        base::endElement(localname, prefix, URI);
+
+    }
+
+    virtual void charactersUnit(const char * ch, int len) override {
+
+        if(skip_depth) return;
+
+        if(name_depth)
+            name_text().append(ch, len);
+        else if(!class_scopes.empty() && class_scopes.back().function.qualifier_depth)
+            class_scopes.back().function.qualifier.append(ch, len);
+
+        base::charactersUnit(ch, len);
+
+    }
+
+private:
+
+    bool is_namespace_child() const {
+        return !scopes.empty() && scopes.back().depth == depth - 1;
+    }
+
+    bool is_class_child() const {
+        return !class_scopes.empty() && class_scopes.back().depth == depth - 1;
+    }
+
+    bool is_class_name() const {
+        return !class_scopes.empty() && class_scopes.back().depth == name_depth - 1;
+    }
+
+    /** the public, private, and protected regions are the children of the class block */
+    bool is_region_child() const {
+        return !class_scopes.empty() && class_scopes.back().block_depth && class_scopes.back().block_depth == depth - 1;
+    }
+
+    bool is_member_child() const {
+        return !class_scopes.empty() && class_scopes.back().block_depth && class_scopes.back().block_depth == depth - 2;
+    }
+
+    bool is_function_child() const {
+        return !class_scopes.empty() && class_scopes.back().function.depth && class_scopes.back().function.depth == depth - 1;
+    }
+
+    bool is_function_name() const {
+        return !class_scopes.empty() && class_scopes.back().function.depth && class_scopes.back().function.depth == name_depth - 1;
+    }
+
+    /** the name being read, of a using directive, a class, a member function, or a namespace */
+    std::string & name_text() {
+
+        if(using_namespace_depth) return using_name;
+        if(is_class_name()) return class_scopes.back().name;
+        if(is_function_name()) return class_scopes.back().function.name;
+
+        return namespace_name;
+
+    }
+
+    void end_name() {
+
+        if(!using_namespace_depth && is_class_name()) {
+
+            std::string & name = class_scopes.back().name;
+            name = name.substr(0, name.find('<'));
+            srcuml::trim(name);
+
+        }
+
+        name_depth = 0;
+
+    }
+
+    /** namespaces and using directives do not carry over to the next unit */
+    void reset_unit() {
+
+        scopes.clear();
+        global_usings.clear();
+
+        using_depth = 0;
+        using_namespace_depth = 0;
+        using_name.clear();
+        name_depth = 0;
+        namespace_name.clear();
+        class_scopes.clear();
+        member_qualifiers.clear();
+
+    }
+
+    /** popped before the class is dispatched, so it is not its own enclosing class */
+    void end_class() {
+
+        member_qualifiers = std::move(class_scopes.back().members);
+        class_scopes.pop_back();
+
+    }
+
+    void end_qualifier() {
+
+        member_function & function = class_scopes.back().function;
+        function.qualifiers |= srcuml_member_qualifiers::get_qualifier_flag(function.qualifier);
+        function.qualifier_depth = 0;
+
+    }
+
+    void end_function() {
+
+        class_scope & aclass = class_scopes.back();
+        aclass.members.add(aclass.access, aclass.function.name, aclass.function.qualifiers);
+        aclass.function = member_function();
+
+    }
+
+    void end_using() {
+
+        srcuml::trim(using_name);
+        if(using_namespace_depth && !using_name.empty())
+            (scopes.empty() ? global_usings : scopes.back().usings).push_back(using_name);
+
+        using_depth = 0;
+        using_namespace_depth = 0;
+        using_name.clear();
+
+    }
+
 };
 
 
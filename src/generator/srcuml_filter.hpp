@@ -0,0 +1,152 @@
+/**
+ * @file srcuml_filter.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INCLUDED_SRCUML_FILTER_HPP
+#define INCLUDED_SRCUML_FILTER_HPP
+
+#include <string>
+#include <vector>
+
+/**
+ * srcuml_filter
+ *
+ * Selects the classes to diagram with glob patterns ('*' and '?') on
+ * namespace qualified class names, e.g., net::* or *Test*.  A class is
+ * kept if it matches an include pattern, or there are none, and matches
+ * no exclude pattern.  Units are excluded by patterns on their filename.
+ *
+ * Whole namespaces are rejected when no class inside them could be kept,
+ * so their contents need not be dispatched.
+ */
+class srcuml_filter {
+
+private:
+
+    std::vector<std::string> includes;
+    std::vector<std::string> excludes;
+    std::vector<std::string> unit_excludes;
+
+public:
+
+    srcuml_filter(const std::vector<std::string> & includes = std::vector<std::string>(),
+                  const std::vector<std::string> & excludes = std::vector<std::string>(),
+                  const std::vector<std::string> & unit_excludes = std::vector<std::string>())
+        : includes(includes),
+          excludes(excludes),
+          unit_excludes(unit_excludes) {}
+
+    bool is_class_included(const std::string & qualified_name) const {
+
+        if(!includes.empty() && !matches_any(includes, qualified_name))
+            return false;
+
+        return !matches_any(excludes, qualified_name);
+
+    }
+
+    /** false if no class in the namespace can be included */
+    bool is_namespace_included(const std::string & qualified_name) const {
+
+        const std::string prefix = qualified_name + "::";
+
+        if(!includes.empty()) {
+
+            bool can_include = false;
+            for(const std::string & pattern : includes)
+                can_include = can_include || can_match_extension(pattern.c_str(), prefix.c_str());
+
+            if(!can_include) return false;
+
+        }
+
+        for(const std::string & pattern : excludes)
+            if(matches_every_extension(pattern.c_str(), prefix.c_str()))
+                return false;
+
+        return true;
+
+    }
+
+    bool is_unit_included(const std::string & filename) const {
+        return !matches_any(unit_excludes, filename);
+    }
+
+    /** match str against a glob pattern */
+    static bool match(const char * pattern, const char * str) {
+
+        if(*pattern == '\0') return *str == '\0';
+
+        if(*pattern == '*')
+            return match(pattern + 1, str) || (*str != '\0' && match(pattern, str + 1));
+
+        return *str != '\0' && (*pattern == '?' || *pattern == *str) && match(pattern + 1, str + 1);
+
+    }
+
+private:
+
+    static bool matches_any(const std::vector<std::string> & patterns, const std::string & str) {
+
+        for(const std::string & pattern : patterns)
+            if(match(pattern.c_str(), str.c_str()))
+                return true;
+
+        return false;
+
+    }
+
+    /** true if the pattern matches some string starting with prefix */
+    static bool can_match_extension(const char * pattern, const char * prefix) {
+
+        if(*prefix == '\0') return true;
+        if(*pattern == '\0') return false;
+
+        if(*pattern == '*')
+            return can_match_extension(pattern + 1, prefix) || can_match_extension(pattern, prefix + 1);
+
+        return (*pattern == '?' || *pattern == *prefix) && can_match_extension(pattern + 1, prefix + 1);
+
+    }
+
+    /** true if the pattern matches every string starting with prefix and longer than it */
+    static bool matches_every_extension(const char * pattern, const char * prefix) {
+
+        if(*prefix == '\0') {
+
+            if(*pattern != '*') return false;
+            while(*pattern == '*') ++pattern;
+            return *pattern == '\0';
+
+        }
+
+        if(*pattern == '\0') return false;
+
+        if(*pattern == '*')
+            return matches_every_extension(pattern + 1, prefix) || matches_every_extension(pattern, prefix + 1);
+
+        return (*pattern == '?' || *pattern == *prefix) && matches_every_extension(pattern + 1, prefix + 1);
+
+    }
+
+};
+
+#endif
@@ -0,0 +1,141 @@
+/**
+ * @file srcuml_graph.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INCLUDED_SRCUML_GRAPH_HPP
+#define INCLUDED_SRCUML_GRAPH_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * srcuml_graph
+ *
+ * Compressed sparse row adjacency over integer node ids.  Edges are
+ * identified by their position in the caller's edge list, which holds
+ * the payloads.  Outgoing and incoming edges of a node are contiguous
+ * and keep edge list order.
+ */
+class srcuml_graph {
+
+public:
+
+    /** edge ids of one node's adjacency */
+    class edge_range {
+
+    private:
+
+        const std::uint32_t * first;
+        const std::uint32_t * last;
+
+    public:
+
+        edge_range(const std::uint32_t * first, const std::uint32_t * last)
+            : first(first),
+              last(last) {}
+
+        const std::uint32_t * begin() const {
+            return first;
+        }
+
+        const std::uint32_t * end() const {
+            return last;
+        }
+
+        std::size_t size() const {
+            return last - first;
+        }
+
+        bool empty() const {
+            return first == last;
+        }
+
+    };
+
+private:
+
+    std::vector<std::uint32_t> out_offsets;
+    std::vector<std::uint32_t> out_edges;
+
+    std::vector<std::uint32_t> in_offsets;
+    std::vector<std::uint32_t> in_edges;
+
+public:
+
+    srcuml_graph()
+        : out_offsets(1, 0),
+          out_edges(),
+          in_offsets(1, 0),
+          in_edges() {}
+
+    /**
+     * Build the adjacency of node_count nodes from edge_count edges.
+     * get_source(edge) and get_destination(edge) return node ids.
+     */
+    template<typename source_t, typename destination_t>
+    void build(std::size_t node_count, std::size_t edge_count, source_t get_source, destination_t get_destination) {
+
+        build_direction(node_count, edge_count, get_source, out_offsets, out_edges);
+        build_direction(node_count, edge_count, get_destination, in_offsets, in_edges);
+
+    }
+
+    std::size_t get_node_count() const {
+        return out_offsets.size() - 1;
+    }
+
+    std::size_t get_edge_count() const {
+        return out_edges.size();
+    }
+
+    edge_range get_out_edges(std::uint32_t node) const {
+        return edge_range(out_edges.data() + out_offsets[node], out_edges.data() + out_offsets[node + 1]);
+    }
+
+    edge_range get_in_edges(std::uint32_t node) const {
+        return edge_range(in_edges.data() + in_offsets[node], in_edges.data() + in_offsets[node + 1]);
+    }
+
+private:
+
+    /** counting sort of the edge ids by node, stable in edge order */
+    template<typename node_t>
+    static void build_direction(std::size_t node_count, std::size_t edge_count, node_t get_node,
+                                std::vector<std::uint32_t> & offsets, std::vector<std::uint32_t> & edges) {
+
+        offsets.assign(node_count + 1, 0);
+        for(std::size_t edge = 0; edge < edge_count; ++edge)
+            ++offsets[get_node(edge) + 1];
+
+        for(std::size_t node = 0; node < node_count; ++node)
+            offsets[node + 1] += offsets[node];
+
+        std::vector<std::uint32_t> next(offsets.begin(), offsets.end() - 1);
+        edges.resize(edge_count);
+        for(std::size_t edge = 0; edge < edge_count; ++edge)
+            edges[next[get_node(edge)]++] = static_cast<std::uint32_t>(edge);
+
+    }
+
+};
+
+#endif
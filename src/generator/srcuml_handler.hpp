@@ -22,18 +22,31 @@
 #ifndef INCLUDED_SRCUML_HANDLER_HPP
 #define INCLUDED_SRCUML_HANDLER_HPP
 
-#include <srcSAXEventDispatchUtilities.hpp>
 #include <srcSAXController.hpp>
 
-#include <srcuml_dispatcher.hpp>
-#include <ClassPolicySingleEvent.hpp>
+#include <srcuml_options.hpp>
+#include <srcuml_filter.hpp>
+#include <srcuml_collector.hpp>
+#include <srcuml_archive.hpp>
+#include <srcuml_input.hpp>
+#include <srcuml_reader.hpp>
+#include <srcuml_source.hpp>
+#include <srcuml_cache.hpp>
+#include <srcuml_model.hpp>
+#include <srcuml_thread_pool.hpp>
+#include <srcuml_arena.hpp>
+#include <srcuml_type_registry.hpp>
 
 #include <srcuml_class.hpp>
 #include <srcuml_relationship.hpp>
 #include <dot_outputter.hpp>
 #include <yuml_outputter.hpp>
+#include <json_outputter.hpp>
+
+#include <libxml/parser.h>
 
 #include <iostream>
+#include <fstream>
 #include <iomanip>
 #include <algorithm>
 #include <memory>
@@ -42,54 +55,314 @@
 /**
  * srcuml_handler
  *
- * Base class that provides hooks for processing.
+ * Parses a srcML archive, or source code converted with libsrcml,
+ * into classes and outputs the diagram.  A saved model is output
+ * without parsing.
+ *
+ * Classes are created in arenas, one per parsed document, that the
+ * handler owns and frees together.  Policy data is freed as each class
+ * is collected, but the summary of every class is kept until output
+ * since relationships are analyzed over all classes at once.
  */
-class srcuml_handler : public srcSAXEventDispatch::PolicyListener {
+class srcuml_handler {
 
 private:
 
-    std::vector<std::shared_ptr<srcuml_class>> classes;
+    std::vector<std::unique_ptr<srcuml_arena>> arenas;
+    std::vector<srcuml_class *> classes;
+
+    std::vector<srcuml_options::output_target> targets;
+    std::vector<std::unique_ptr<srcuml_outputter>> outputters;
 
 public:
 
-    srcuml_handler(const std::string & input_str, std::ostream & out) {
+    srcuml_handler(const std::string & input_str, std::ostream & out, const srcuml_options & options = srcuml_options()) {
 
-        srcSAXController controller(input_str);
-        run(controller, out);
+        create_outputters(options);
+        configure(options);
+        parse(input_str.c_str(), input_str.size(), options);
+        output(out, options);
 
     }
 
-    srcuml_handler(const char * input_filename, std::ostream & out) {
+    srcuml_handler(const char * input_filename, std::ostream & out, const srcuml_options & options = srcuml_options()) {
+
+        create_outputters(options);
+
+        srcuml_input input(input_filename);
+        if(srcuml_model::is_model(input.get_data(), input.get_size())) {
+
+            srcuml_model model(input.get_data(), input.get_size(), input_filename);
+            srcuml_relationships relationships(model.get_classes(), model.get_relationships());
+            output(out, model.get_classes(), relationships, options);
+            return;
+
+        }
+
+        configure(options);
+        parse(input.get_data(), input.get_size(), options);
+        output(out, options);
+
+    }
+
+    /** convert the source files to srcML in memory and parse them, no srcML is written */
+    srcuml_handler(const srcuml_source & source, std::ostream & out, const srcuml_options & options = srcuml_options()) {
+
+        create_outputters(options);
+        configure(options);
+
+        std::unique_ptr<srcuml_cache> cache;
+        if(!options.cache_file.empty())
+            cache.reset(new srcuml_cache(options.cache_file, get_cache_settings(options)));
+
+        srcuml_filter filter(options.includes, options.excludes, options.unit_excludes);
+
+        std::vector<std::uint64_t> hashes(source.size());
+        std::vector<std::vector<srcuml_class *>> unit_classes(source.size());
+        parse_parallel(unit_classes, options, [&](std::size_t pos, srcuml_arena & arena, std::vector<srcuml_class *> & parsed_classes) {
+
+            if(!filter.is_unit_included(source.get_file(pos))) return;
+
+            std::string contents = source.read(pos);
+            hashes[pos] = srcuml::hash(contents.c_str(), contents.size());
+            if(cache && cache->load(source.get_file(pos), hashes[pos], arena, parsed_classes)) return;
+
+            source.convert(pos, contents, [&](const char * buffer, std::size_t size) {
+
+                srcuml_reader reader(buffer, size, !options.dependencies);
+                parse(reader, filter, arena, parsed_classes);
+
+            });
+
+        });
+
+        if(cache) {
+
+            std::vector<srcuml_cache::unit> units;
+            for(std::size_t pos = 0; pos < source.size(); ++pos)
+                if(filter.is_unit_included(source.get_file(pos)))
+                    units.push_back(srcuml_cache::unit{ source.get_file(pos), hashes[pos], &unit_classes[pos] });
+            cache->save(units);
+
+        }
 
-        srcSAXController controller(input_filename);
-        run(controller, out);
+        output(out, options);
 
     }
 
     ~srcuml_handler() {}
 
-    void run(srcSAXController & controller, std::ostream & out) {
+private:
+
+    /** register the configured types in place of any earlier ones, must happen before any parsing */
+    static void configure(const srcuml_options & options) {
+
+        srcuml_type_registry & registry = srcuml_type_registry::get_registry();
+        registry.reset();
+
+        if(!options.type_config.empty())
+            registry.load(options.type_config);
+
+    }
+
+    /** everything that changes the classes parsed from a unit */
+    static std::string get_cache_settings(const srcuml_options & options) {
 
-        srcuml_dispatcher<ClassPolicy> dispatcher(this);
-        controller.parse(&dispatcher);
-        dot_outputter outputter;
-        outputter.output(out, classes);
+        return options.get_parse_settings() + "\ntypes\n" + srcuml_type_registry::get_registry().get_settings();
 
     }
 
-    virtual void Notify(const srcSAXEventDispatch::PolicyDispatcher * policy, const srcSAXEventDispatch::srcSAXEventContext & ctx) override {
+    static void parse(srcuml_reader & reader, const srcuml_filter & filter, srcuml_arena & arena, std::vector<srcuml_class *> & parsed_classes) {
+
+        srcSAXController controller(&reader, srcuml_reader::read, srcuml_reader::close);
+        srcuml_collector collector(arena, parsed_classes, filter);
+        collector.parse(controller);
+
+    }
+
+    void parse(const char * buffer, std::size_t size, const srcuml_options & options) {
+
+        if(options.jobs == 1 && options.cache_file.empty() && options.unit_excludes.empty()) {
+
+            srcuml_reader reader(buffer, size, !options.dependencies);
+            arenas.emplace_back(new srcuml_arena());
+            parse(reader, srcuml_filter(options.includes, options.excludes), *arenas.back(), classes);
 
-        if(typeid(ClassPolicy) == typeid(*policy)) {
+        } else {
 
-            ClassPolicy::ClassData * class_data = policy->Data<ClassPolicy::ClassData>();
-            if(class_data && class_data->name)
-                classes.emplace_back(std::make_shared<srcuml_class>(class_data));
+            parse_units(buffer, size, options);
 
         }
 
     }
 
-private:
+    /**
+     * Parse each unit of the archive on its own.  Unchanged units are read
+     * from the cache and excluded units are skipped.  A document that is not
+     * an archive is treated as an archive of one unit.
+     */
+    void parse_units(const char * buffer, std::size_t size, const srcuml_options & options) {
+
+        srcuml_filter filter(options.includes, options.excludes, options.unit_excludes);
+
+        std::unique_ptr<srcuml_cache> cache;
+        if(!options.cache_file.empty())
+            cache.reset(new srcuml_cache(options.cache_file, get_cache_settings(options)));
+
+        srcuml_archive archive(buffer, size);
+        if(!archive.is_archive()) {
+
+            parse_unit(buffer, size, archive.get_root_filename(), filter, cache.get(), options);
+            return;
+
+        }
+
+        std::vector<std::vector<srcuml_class *>> unit_classes(archive.size());
+        parse_parallel(unit_classes, options, [&](std::size_t pos, srcuml_arena & arena, std::vector<srcuml_class *> & parsed_classes) {
+
+            if(!filter.is_unit_included(archive.get_filename(pos))) return;
+            if(cache && cache->load(archive.get_filename(pos), archive.get_hash(pos), arena, parsed_classes)) return;
+
+            srcuml_reader reader(!options.dependencies);
+            archive.add_unit_document(reader, pos);
+            parse(reader, filter, arena, parsed_classes);
+
+        });
+
+        if(cache) {
+
+            std::vector<srcuml_cache::unit> units;
+            for(std::size_t pos = 0; pos < archive.size(); ++pos)
+                if(filter.is_unit_included(archive.get_filename(pos)))
+                    units.push_back(srcuml_cache::unit{ archive.get_filename(pos), archive.get_hash(pos), &unit_classes[pos] });
+            cache->save(units);
+
+        }
+
+    }
+
+    /** parse a document that is a single unit, the same way as a unit of an archive */
+    void parse_unit(const char * buffer, std::size_t size, const std::string & filename,
+                    const srcuml_filter & filter, const srcuml_cache * cache, const srcuml_options & options) {
+
+        if(!filter.is_unit_included(filename)) return;
+
+        std::uint64_t hash = srcuml::hash(buffer, size);
+        arenas.emplace_back(new srcuml_arena());
+        if(cache && cache->load(filename, hash, *arenas.back(), classes)) return;
+
+        srcuml_reader reader(buffer, size, !options.dependencies);
+        parse(reader, filter, *arenas.back(), classes);
+
+        if(cache)
+            cache->save(std::vector<srcuml_cache::unit>{ srcuml_cache::unit{ filename, hash, &classes } });
+
+    }
+
+    /**
+     * Call parse_document(pos, arena, unit_classes[pos]) for every document
+     * on the thread pool.  Every document is parsed with its own controller,
+     * dispatcher, and arena, and classes are merged in document order so the
+     * result matches a single threaded parse.
+     */
+    template<typename function_t>
+    void parse_parallel(std::vector<std::vector<srcuml_class *>> & unit_classes, const srcuml_options & options, function_t parse_document) {
+
+        // libxml2 must be initialized before parsing on several threads
+        xmlInitParser();
+
+        std::vector<std::unique_ptr<srcuml_arena>> unit_arenas(unit_classes.size());
+
+        srcuml_thread_pool pool(options.jobs);
+        pool.parallel_for(unit_classes.size(), [&](std::size_t pos) {
+
+            unit_arenas[pos].reset(new srcuml_arena());
+            parse_document(pos, *unit_arenas[pos], unit_classes[pos]);
+
+        });
+
+        for(std::unique_ptr<srcuml_arena> & arena : unit_arenas)
+            if(arena->get_allocated())
+                arenas.emplace_back(std::move(arena));
+
+        for(const std::vector<srcuml_class *> & unit : unit_classes)
+            classes.insert(classes.end(), unit.begin(), unit.end());
+
+    }
+
+    /** analyze relationships, save the model if asked, and output */
+    void output(std::ostream & out, const srcuml_options & options) {
+
+        srcuml_relationships relationships(classes, options.dependencies, options.jobs);
+        if(!options.model_file.empty())
+            srcuml_model::save(options.model_file, classes, relationships.get_relationships());
+
+        output(out, classes, relationships, options);
+
+    }
+
+    /** render every target from the same read-only classes and relationships, the targets concurrently */
+    void output(std::ostream & out, std::vector<srcuml_class *> & classes, srcuml_relationships & relationships, const srcuml_options & options) {
+
+        srcuml_thread_pool pool(std::min(targets.size(), get_jobs(options)));
+        pool.parallel_for(targets.size(), [&](std::size_t pos) {
+
+            if(targets[pos].filename.empty()) {
+
+                outputters[pos]->output(out, classes, relationships);
+                return;
+
+            }
+
+            std::ofstream file(targets[pos].filename);
+            outputters[pos]->output(file, classes, relationships);
+            file.flush();
+            if(!file)
+                throw std::runtime_error("Unable to write output file: " + targets[pos].filename);
+
+        });
+
+    }
+
+    /** check the output formats before anything is parsed, the jobs are shared by the targets */
+    void create_outputters(const srcuml_options & options) {
+
+        targets = options.outputs;
+        if(targets.empty())
+            targets.push_back(srcuml_options::output_target{ "dot", "" });
+
+        std::size_t stream_targets = 0;
+        std::size_t target_jobs = std::max<std::size_t>(1, get_jobs(options) / targets.size());
+        for(const srcuml_options::output_target & target : targets) {
+
+            if(target.filename.empty())
+                ++stream_targets;
+
+            if(target.format == "dot")
+                outputters.emplace_back(new dot_outputter(target_jobs));
+            else if(target.format == "yuml")
+                outputters.emplace_back(new yuml_outputter(target_jobs));
+            else if(target.format == "json")
+                outputters.emplace_back(new json_outputter(target_jobs));
+            else
+                throw std::runtime_error("Unknown output format: " + target.format);
+
+        }
+
+        if(stream_targets > 1)
+            throw std::runtime_error("Only one output format can be written to the output stream");
+
+    }
+
+    /** number of threads to use, 0 jobs is all cores */
+    static std::size_t get_jobs(const srcuml_options & options) {
+
+        if(options.jobs != 0)
+            return options.jobs;
+
+        return std::max(1u, std::thread::hardware_concurrency());
+
+    }
 
 };
 
@@ -0,0 +1,150 @@
+/**
+ * @file srcuml_input.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDED_SRCUML_INPUT_HPP
+#define INCLUDED_SRCUML_INPUT_HPP
+
+#include <string>
+#include <stdexcept>
+#include <cerrno>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * srcuml_input
+ *
+ * Contents of an input file.  Regular files are memory mapped read-only
+ * with a sequential access hint, so the parser reads straight from the
+ * page cache.  Anything that cannot be mapped (pipes, empty files) is
+ * read into memory instead.
+ */
+class srcuml_input {
+
+private:
+
+    const char * data;
+    std::size_t size;
+
+    bool is_mapped;
+    std::string buffer;
+
+public:
+
+    srcuml_input(const char * filename)
+        : data(nullptr),
+          size(0),
+          is_mapped(false),
+          buffer() {
+
+            // a pipe is read through the descriptor it was opened with, opening it again would wait for another writer
+            int fd = open(filename, O_RDONLY);
+            if(fd == -1)
+                throw std::runtime_error(std::string("Unable to open input file: ") + filename);
+
+            map(fd);
+            if(!is_mapped && !read_all(fd)) {
+
+                close(fd);
+                throw std::runtime_error(std::string("Unable to read input file: ") + filename);
+
+            }
+
+            // the mapping stays valid after the descriptor is closed
+            close(fd);
+
+    }
+
+    ~srcuml_input() {
+
+        if(is_mapped)
+            munmap(const_cast<char *>(data), size);
+
+    }
+
+    srcuml_input(const srcuml_input &) = delete;
+    srcuml_input & operator=(const srcuml_input &) = delete;
+
+    const char * get_data() const {
+        return data;
+    }
+
+    std::size_t get_size() const {
+        return size;
+    }
+
+    bool get_is_mapped() const {
+        return is_mapped;
+    }
+
+private:
+
+    void map(int fd) {
+
+        struct stat file_stat;
+        if(fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode) && file_stat.st_size > 0) {
+
+            void * mapping = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(mapping != MAP_FAILED) {
+
+                madvise(mapping, file_stat.st_size, MADV_SEQUENTIAL);
+
+                data = static_cast<const char *>(mapping);
+                size = file_stat.st_size;
+                is_mapped = true;
+
+            }
+
+        }
+
+    }
+
+    bool read_all(int fd) {
+
+        char block[1 << 16];
+        for(;;) {
+
+            ssize_t count = read(fd, block, sizeof(block));
+            if(count == 0) break;
+
+            if(count == -1) {
+
+                if(errno == EINTR) continue;
+                return false;
+
+            }
+
+            buffer.append(block, count);
+
+        }
+
+        data = buffer.c_str();
+        size = buffer.size();
+
+        return true;
+
+    }
+
+};
+
+#endif
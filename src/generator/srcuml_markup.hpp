@@ -0,0 +1,123 @@
+/**
+ * @file srcuml_markup.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INCLUDED_SRCUML_MARKUP_HPP
+#define INCLUDED_SRCUML_MARKUP_HPP
+
+#include <string>
+#include <algorithm>
+#include <cstring>
+#include <cctype>
+
+/**
+ * srcuml_markup
+ *
+ * Finds tags in srcML text without parsing it.  srcML escapes '<' in
+ * content, so every '<' starts markup.
+ */
+class srcuml_markup {
+
+private:
+
+    const char * buffer;
+    std::size_t buffer_size;
+
+public:
+
+    srcuml_markup(const char * buffer, std::size_t size)
+        : buffer(buffer),
+          buffer_size(size) {}
+
+    /** position of the next '<' at or after pos, the size if there is none */
+    std::size_t find_markup(std::size_t pos) const {
+
+        const void * found = pos < buffer_size ? std::memchr(buffer + pos, '<', buffer_size - pos) : nullptr;
+        return found ? static_cast<const char *>(found) - buffer : buffer_size;
+
+    }
+
+    /** position after the '>' of the tag starting at pos, skipping quoted attribute values */
+    std::size_t find_tag_end(std::size_t pos) const {
+
+        char quote = 0;
+        for(; pos < buffer_size; ++pos) {
+
+            if(quote) {
+                if(buffer[pos] == quote) quote = 0;
+            } else if(buffer[pos] == '"' || buffer[pos] == '\'') {
+                quote = buffer[pos];
+            } else if(buffer[pos] == '>') {
+                return pos + 1;
+            }
+
+        }
+
+        return buffer_size;
+
+    }
+
+    /** true if the tag name at pos, just after the '<', is name */
+    bool is_tag(std::size_t pos, const std::string & name) const {
+
+        std::size_t name_end = pos + name.size();
+        if(name_end >= buffer_size || name.compare(0, name.size(), buffer + pos, name.size()) != 0)
+            return false;
+
+        return isspace(buffer[name_end]) || buffer[name_end] == '>' || buffer[name_end] == '/';
+
+    }
+
+    /** true if the tag ending at tag_end is an empty element */
+    bool is_empty_tag(std::size_t tag_end) const {
+        return tag_end >= 2 && buffer[tag_end - 2] == '/';
+    }
+
+    /**
+     * Position of the end tag matching the name start tag that ends at pos,
+     * the size if it is missing.
+     */
+    std::size_t find_end_tag(std::size_t pos, const std::string & name) const {
+
+        const std::string end_name = "/" + name;
+
+        std::size_t depth = 1;
+        for(pos = find_markup(pos); pos < buffer_size; pos = find_markup(pos + 1)) {
+
+            if(is_tag(pos + 1, end_name)) {
+
+                if(--depth == 0) return pos;
+
+            } else if(is_tag(pos + 1, name) && !is_empty_tag(find_tag_end(pos))) {
+
+                ++depth;
+
+            }
+
+        }
+
+        return buffer_size;
+
+    }
+
+};
+
+#endif
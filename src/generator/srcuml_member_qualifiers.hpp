@@ -0,0 +1,137 @@
+/**
+ * @file srcuml_member_qualifiers.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDED_SRCUML_MEMBER_QUALIFIERS_HPP
+#define INCLUDED_SRCUML_MEMBER_QUALIFIERS_HPP
+
+#include <ClassPolicySingleEvent.hpp>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cctype>
+
+/**
+ * srcuml_member_qualifiers
+ *
+ * The volatile and reference qualifiers of the member functions of a
+ * class, which the function policy data does not keep.  The dispatcher
+ * adds every member function in document order, and the class takes the
+ * qualifiers back in the order it reads the functions of each access and
+ * name, so overloads that differ only in qualifiers each get their own.
+ */
+class srcuml_member_qualifiers {
+
+public:
+
+    /** qualifiers after the parameter list, other than const */
+    enum qualifier_flag : std::uint32_t {
+
+        NO_QUALIFIER = 0,
+        VOLATILE     = 1 << 0,
+        LVALUE_REF   = 1 << 1,
+        RVALUE_REF   = 1 << 2
+
+    };
+
+private:
+
+    struct member_function {
+
+        ClassPolicy::AccessSpecifier access;
+        std::string name;
+        std::uint32_t qualifiers;
+        bool taken;
+
+    };
+
+    std::vector<member_function> functions;
+
+    /** without any qualifiers every function takes none, so nothing is searched */
+    bool has_qualifiers;
+
+public:
+
+    srcuml_member_qualifiers() : functions(), has_qualifiers(false) {}
+
+    void add(ClassPolicy::AccessSpecifier access, const std::string & name, std::uint32_t qualifiers) {
+
+        functions.push_back(member_function{ access, normalize(name), qualifiers, false });
+        has_qualifiers = has_qualifiers || qualifiers != NO_QUALIFIER;
+
+    }
+
+    /** qualifiers of the next function of the access with the name */
+    std::uint32_t take(ClassPolicy::AccessSpecifier access, const std::string & name) {
+
+        if(!has_qualifiers) return NO_QUALIFIER;
+
+        const std::string key = normalize(name);
+        for(member_function & function : functions) {
+
+            if(function.taken || function.access != access || function.name != key) continue;
+
+            function.taken = true;
+            return function.qualifiers;
+
+        }
+
+        return NO_QUALIFIER;
+
+    }
+
+    void clear() {
+
+        functions.clear();
+        has_qualifiers = false;
+
+    }
+
+    /** qualifier flag of the text of a specifier or reference qualifier */
+    static std::uint32_t get_qualifier_flag(const std::string & text) {
+
+        const std::string qualifier = normalize(text);
+        if(qualifier == "volatile") return VOLATILE;
+        if(qualifier == "&") return LVALUE_REF;
+        if(qualifier == "&&") return RVALUE_REF;
+
+        return NO_QUALIFIER;
+
+    }
+
+private:
+
+    /** srcML keeps the spacing of names such as 'operator =', so it is not compared */
+    static std::string normalize(const std::string & name) {
+
+        std::string normalized;
+        normalized.reserve(name.size());
+        for(char character : name)
+            if(!isspace(character))
+                normalized += character;
+
+        return normalized;
+
+    }
+
+};
+
+#endif
@@ -0,0 +1,160 @@
+/**
+ * @file srcuml_model.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INCLUDED_SRCUML_MODEL_HPP
+#define INCLUDED_SRCUML_MODEL_HPP
+
+#include <srcuml_class.hpp>
+#include <srcuml_relationship.hpp>
+#include <srcuml_binary.hpp>
+#include <srcuml_input.hpp>
+#include <srcuml_arena.hpp>
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <cstring>
+#include <stdexcept>
+#include <cstdint>
+
+/**
+ * srcuml_model
+ *
+ * Analyzed classes and their relationships in a compact binary file.
+ * Classes are stored after inheritance is resolved, so a loaded model can
+ * be output by any outputter without parsing or analyzing again.
+ *
+ * The file is the magic, a version, the classes, and the relationships.
+ * It is memory mapped when read, but it is not used in place: the
+ * variable length records are decoded into classes in the arena, and the
+ * mapping is released once they are loaded.
+ */
+class srcuml_model {
+
+public:
+
+    /** increment whenever the stored classes or relationships change */
+    static const std::uint64_t VERSION = 9;
+
+private:
+
+    srcuml_arena arena;
+    std::vector<srcuml_class *> classes;
+    std::vector<srcuml_relationship> relationships;
+
+public:
+
+    srcuml_model(const char * filename)
+        : arena(),
+          classes(),
+          relationships() {
+
+            srcuml_input input(filename);
+            read(input.get_data(), input.get_size(), filename);
+
+    }
+
+    /** model already in memory, e.g., an input file that turned out to be a model */
+    srcuml_model(const char * data, std::size_t size, const std::string & filename)
+        : arena(),
+          classes(),
+          relationships() {
+
+            read(data, size, filename);
+
+    }
+
+    std::vector<srcuml_class *> & get_classes() {
+        return classes;
+    }
+
+    const std::vector<srcuml_relationship> & get_relationships() const {
+        return relationships;
+    }
+
+    /** true if the data starts with the model file magic */
+    static bool is_model(const char * data, std::size_t size) {
+        return size >= 8 && std::memcmp(data, magic(), 8) == 0;
+    }
+
+    /** write analyzed classes and their relationships */
+    static void save(const std::string & filename,
+                     const std::vector<srcuml_class *> & classes,
+                     const std::vector<srcuml_relationship> & relationships) {
+
+        std::string buffer;
+        srcuml_binary_writer writer(buffer);
+
+        writer.write_raw(magic(), 8);
+        writer.write_uint(VERSION);
+
+        writer.write_uint(classes.size());
+        for(const srcuml_class * aclass : classes)
+            aclass->write(writer);
+
+        writer.write_uint(relationships.size());
+        for(const srcuml_relationship & relationship : relationships)
+            relationship.write(writer);
+
+        std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+        out.write(buffer.data(), buffer.size());
+        if(!out)
+            throw std::runtime_error("Unable to write model file: " + filename);
+
+    }
+
+private:
+
+    void read(const char * data, std::size_t size, const std::string & filename) {
+
+        if(!is_model(data, size))
+            throw std::runtime_error("Not a srcUML model file: " + filename);
+
+        try {
+
+            srcuml_binary_reader reader(data, size);
+            reader.read_raw(8);
+            if(reader.read_uint() != VERSION)
+                throw std::runtime_error("unsupported version");
+
+            for(std::size_t count = reader.read_uint(); count > 0; --count)
+                classes.push_back(arena.create<srcuml_class>(reader));
+
+            for(std::size_t count = reader.read_uint(); count > 0; --count)
+                relationships.emplace_back(reader);
+
+        } catch(const std::runtime_error & error) {
+
+            throw std::runtime_error("Unable to read model file " + filename + ": " + error.what());
+
+        }
+
+    }
+
+    static const char * magic() {
+        return "srcUMLm\n";
+    }
+
+};
+
+#endif
@@ -26,49 +26,254 @@
 
 #include <srcuml_type.hpp>
 #include <srcuml_parameter.hpp>
+#include <srcuml_member_qualifiers.hpp>
 
 #include <srcuml_utilities.hpp>
 
-#include <sstream>
-#include <iterator>
 #include <string>
-#include <set>
+#include <vector>
+#include <array>
+#include <utility>
+#include <cstdint>
+#include <cctype>
 
+/**
+ * srcuml_operation
+ *
+ * Summary of a method or operator.  Types and stereotypes are resolved
+ * on construction so rendering only reads stored values.
+ */
 class srcuml_operation {
 
+public:
+
+    /** method stereotypes as bits, names not listed are only kept as text */
+    enum stereotype_flag : std::uint32_t {
+
+        NO_STEREOTYPE    = 0,
+        GET              = 1 << 0,
+        SET              = 1 << 1,
+        PREDICATE        = 1 << 2,
+        PROPERTY         = 1 << 3,
+        VOID_ACCESSOR    = 1 << 4,
+        COMMAND          = 1 << 5,
+        NON_VOID_COMMAND = 1 << 6,
+        COLLABORATOR     = 1 << 7,
+        CONTROLLER       = 1 << 8,
+        FACTORY          = 1 << 9,
+        EMPTY            = 1 << 10,
+        STATELESS        = 1 << 11,
+        INCIDENTAL       = 1 << 12,
+        WRAPPER          = 1 << 13
+
+    };
+
+    /** accessors are left out of the rendered class */
+    static const std::uint32_t ACCESSOR = GET | SET;
+
 private:
-    const FunctionPolicy::FunctionData * data;
     const ClassPolicy::AccessSpecifier visibility;
 
-    std::set<std::string> stereotypes;
+    std::string name;
+
+    /** volatile and reference qualifiers, as srcuml_member_qualifiers flags */
+    std::uint32_t qualifiers;
+
+    /** hash of the name, parameter types, and qualifiers */
+    std::uint64_t signature_hash;
+
+    std::vector<srcuml_parameter> parameters;
+
+    bool has_return_type;
+    srcuml_type return_type;
+
+    std::vector<srcuml_type> local_types;
+
+    bool is_static;
+    bool is_const;
+    bool is_pure_virtual;
+
+    std::string stereotype;
+    std::uint32_t stereotypes;
 
 public:
-    srcuml_operation(const FunctionPolicy::FunctionData * data, ClassPolicy::AccessSpecifier visibility)
-        : data(data),
-          visibility(visibility) {
+    srcuml_operation(const FunctionPolicy::FunctionData * data, ClassPolicy::AccessSpecifier visibility,
+                     std::uint32_t qualifiers = srcuml_member_qualifiers::NO_QUALIFIER)
+        : visibility(visibility),
+          name(data->name->SimpleName()),
+          qualifiers(qualifiers),
+          signature_hash(hash_signature(name, data, qualifiers)),
+          parameters(),
+          has_return_type(data->returnType),
+          return_type(),
+          local_types(),
+          is_static(data->isStatic),
+          is_const(data->isConst),
+          is_pure_virtual(data->isPureVirtual),
+          stereotype(data->stereotype),
+          stereotypes(NO_STEREOTYPE) {
+
+            analyze_stereotype();
+            analyze_operation(data);
+    }
 
-            std::istringstream stream(data->stereotype);
-            stereotypes = std::set<std::string>(std::istream_iterator<std::string>(stream), std::istream_iterator<std::string>());
+    srcuml_operation(srcuml_binary_reader & reader)
+        : visibility((ClassPolicy::AccessSpecifier)reader.read_uint()),
+          name(reader.read_string()),
+          qualifiers(static_cast<std::uint32_t>(reader.read_uint())),
+          signature_hash(reader.read_uint()),
+          parameters(),
+          has_return_type(false),
+          return_type(),
+          local_types(),
+          is_static(false),
+          is_const(false),
+          is_pure_virtual(false),
+          stereotype(),
+          stereotypes(NO_STEREOTYPE) {
+
+            for(std::size_t count = reader.read_uint(); count > 0; --count)
+                parameters.emplace_back(reader);
+
+            has_return_type = reader.read_bool();
+            return_type = srcuml_type(reader);
+
+            for(std::size_t count = reader.read_uint(); count > 0; --count)
+                local_types.emplace_back(reader);
+
+            is_static = reader.read_bool();
+            is_const = reader.read_bool();
+            is_pure_virtual = reader.read_bool();
+            stereotype = reader.read_string();
+            stereotypes = static_cast<std::uint32_t>(reader.read_uint());
 
-            analyze_operation();
     }
 
-    // ~srcuml_operation() { if(data) delete data; }
+    void write(srcuml_binary_writer & writer) const {
+
+        writer.write_uint(visibility);
+        writer.write_string(name);
+        writer.write_uint(qualifiers);
+        writer.write_uint(signature_hash);
+
+        writer.write_uint(parameters.size());
+        for(const srcuml_parameter & parameter : parameters)
+            parameter.write(writer);
+
+        writer.write_bool(has_return_type);
+        return_type.write(writer);
 
-    const FunctionPolicy::FunctionData & get_data() const {
+        writer.write_uint(local_types.size());
+        for(const srcuml_type & local_type : local_types)
+            local_type.write(writer);
 
-        return *data;
+        writer.write_bool(is_static);
+        writer.write_bool(is_const);
+        writer.write_bool(is_pure_virtual);
+        writer.write_string(stereotype);
+        writer.write_uint(stereotypes);
 
     }
 
-    const std::set<std::string> & get_stereotypes() const {
+    ClassPolicy::AccessSpecifier get_visibility() const {
+        return visibility;
+    }
+
+    const std::string & get_name() const {
+        return name;
+    }
+
+    std::uint64_t get_signature_hash() const {
+        return signature_hash;
+    }
 
+    /** same signature, checked past the hash so a collision is not a match */
+    bool has_same_signature(const srcuml_operation & other) const {
+
+        if(signature_hash != other.signature_hash || is_const != other.is_const || qualifiers != other.qualifiers
+            || name != other.name || parameters.size() != other.parameters.size())
+            return false;
+
+        for(std::size_t pos = 0; pos < parameters.size(); ++pos)
+            if(parameters[pos].get_type() != other.parameters[pos].get_type())
+                return false;
+
+        return true;
+
+    }
+
+    const std::vector<srcuml_parameter> & get_parameters() const {
+        return parameters;
+    }
+
+    bool get_has_return_type() const {
+        return has_return_type;
+    }
+
+    const srcuml_type & get_return_type() const {
+        return return_type;
+    }
+
+    /** types of the local declarations, used for dependencies */
+    const std::vector<srcuml_type> & get_local_types() const {
+        return local_types;
+    }
+
+    bool get_is_static() const {
+        return is_static;
+    }
+
+    bool get_is_const() const {
+        return is_const;
+    }
+
+    /** srcuml_member_qualifiers flags of the volatile and reference qualifiers */
+    std::uint32_t get_qualifiers() const {
+        return qualifiers;
+    }
+
+    bool get_is_pure_virtual() const {
+        return is_pure_virtual;
+    }
+
+    /** the stereotype text from srcML, including names without a flag */
+    const std::string & get_stereotype() const {
+        return stereotype;
+    }
+
+    std::uint32_t get_stereotypes() const {
         return stereotypes;
+    }
+
+    /** srcML name of each stereotype flag */
+    static const std::array<std::pair<const char *, stereotype_flag>, 14> & get_stereotype_names() {
+
+        static const std::array<std::pair<const char *, stereotype_flag>, 14> names = {{
+            { "get", GET }, { "set", SET }, { "predicate", PREDICATE }, { "property", PROPERTY },
+            { "void-accessor", VOID_ACCESSOR }, { "command", COMMAND }, { "non-void-command", NON_VOID_COMMAND },
+            { "collaborator", COLLABORATOR }, { "controller", CONTROLLER }, { "factory", FACTORY },
+            { "empty", EMPTY }, { "stateless", STATELESS }, { "incidental", INCIDENTAL }, { "wrapper", WRAPPER }
+        }};
 
+        return names;
+
+    }
+
+    /** true if any of the stereotype bits is set */
+    bool has_stereotype(std::uint32_t stereotype_flags) const {
+        return (stereotypes & stereotype_flags) != 0;
     }
 
     friend std::ostream & operator<<(std::ostream & out, const srcuml_operation & operation) {
 
+        srcuml_output_buffer buffer(out);
+        buffer << operation;
+        return out;
+
+    }
+
+    friend srcuml_output_buffer & operator<<(srcuml_output_buffer & out, const srcuml_operation & operation) {
+
         if(operation.visibility == ClassPolicy::PUBLIC)
             out << '+';
         else if(operation.visibility == ClassPolicy::PRIVATE)
@@ -78,34 +283,32 @@ public:
 
         out << ' ';
 
-        out << operation.data->name->SimpleName();
+        out << operation.name;
 
         out << '(';
-        for(std::size_t pos = 0; pos < operation.data->parameters.size(); ++pos) {
+        for(std::size_t pos = 0; pos < operation.parameters.size(); ++pos) {
 
             if(pos != 0)
                 out << ", ";
 
-            srcuml_parameter the_parameter(operation.data->parameters[pos]);
-            out << the_parameter;
+            out << operation.parameters[pos];
 
         }
         out << ')';
 
-        if(operation.data->returnType) {
+        if(operation.has_return_type) {
 
-            srcuml_type the_type(operation.data->returnType);
-            if(the_type.get_type_name() != "void") {
+            if(operation.return_type.get_type_name() != "void") {
                 out << ": ";
-                out << the_type;
+                out << operation.return_type;
             }            
 
         }
 
-        if(!operation.data->stereotype.empty()) {
+        if(!operation.stereotype.empty()) {
 
             out << " ｛";
-            out << operation.data->stereotype;
+            out << operation.stereotype;
             out << "｝";
 
         }
@@ -116,7 +319,71 @@ public:
 
 private:
 
-    void analyze_operation() {}
+    /**
+     * Hash of the normalized signature: the name that is compared, the
+     * structure of each parameter type, and the qualifiers.  Parameter names
+     * and the return type are left out, as they do not affect overriding.
+     */
+    static std::uint64_t hash_signature(const std::string & name, const FunctionPolicy::FunctionData * data, std::uint32_t qualifiers) {
+
+        std::uint64_t value = srcuml::hash(name.c_str(), name.size() + 1);
+
+        for(const ParamTypePolicy::ParamTypeData * parameter : data->parameters)
+            value = srcuml::hash(",", 1, srcuml_type::hash_key(parameter->type, value));
+
+        const char key[] = { data->isConst ? 'c' : 'm', static_cast<char>('0' + qualifiers) };
+        return srcuml::hash(key, sizeof(key), value);
+
+    }
+
+    static std::uint32_t get_stereotype_flag(const char * begin, const char * end) {
+
+        const std::size_t length = end - begin;
+        for(const std::pair<const char *, stereotype_flag> & name : get_stereotype_names()) {
+
+            if(std::char_traits<char>::length(name.first) == length
+                && std::char_traits<char>::compare(name.first, begin, length) == 0)
+                return name.second;
+
+        }
+
+        return NO_STEREOTYPE;
+
+    }
+
+    /** the stereotype text is a whitespace separated list of names */
+    void analyze_stereotype() {
+
+        const char * pos = stereotype.c_str();
+        const char * end = pos + stereotype.size();
+        while(pos != end) {
+
+            while(pos != end && isspace(*pos))
+                ++pos;
+
+            const char * word = pos;
+            while(pos != end && !isspace(*pos))
+                ++pos;
+
+            if(word != pos)
+                stereotypes |= get_stereotype_flag(word, pos);
+
+        }
+
+    }
+
+    void analyze_operation(const FunctionPolicy::FunctionData * data) {
+
+        for(const ParamTypePolicy::ParamTypeData * parameter : data->parameters)
+            parameters.emplace_back(parameter);
+
+        if(has_return_type)
+            return_type = srcuml_type(data->returnType);
+
+        for(const DeclTypePolicy::DeclTypeData * relation : data->relations)
+            local_types.emplace_back(relation->type);
+
+    }
 
 };
 
@@ -0,0 +1,139 @@
+/**
+ * @file srcuml_options.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDED_SRCUML_OPTIONS_HPP
+#define INCLUDED_SRCUML_OPTIONS_HPP
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cstddef>
+
+/**
+ * srcuml_options
+ *
+ * Settings for a srcuml_handler run.
+ */
+struct srcuml_options {
+
+    /** a diagram format and the file it is written to, the handler's stream if empty */
+    struct output_target {
+
+        std::string format;
+        std::string filename;
+
+    };
+
+    srcuml_options()
+        : jobs(1),
+          dependencies(true),
+          includes(),
+          excludes(),
+          unit_excludes(),
+          type_config(),
+          cache_file(),
+          model_file(),
+          outputs() {}
+
+    /** number of parsing threads, 0 uses all cores */
+    std::size_t jobs;
+
+    /** generate dependencies from function bodies, bodies are not parsed if false */
+    bool dependencies;
+
+    /** glob patterns on qualified class names, see srcuml_filter */
+    std::vector<std::string> includes;
+    std::vector<std::string> excludes;
+
+    /** glob patterns on unit filenames, matching units are not parsed */
+    std::vector<std::string> unit_excludes;
+
+    /** extra type names by category, see srcuml_type_registry::load */
+    std::string type_config;
+
+    /** per-unit analysis cache, none if empty */
+    std::string cache_file;
+
+    /** write the analyzed model here, none if empty */
+    std::string model_file;
+
+    /** diagrams rendered from the one analysis, dot to the handler's stream if empty */
+    std::vector<output_target> outputs;
+
+    /**
+     * Pair each format with the file in the same position, a format value
+     * may be a comma separated list.  A single diagram is written to the
+     * handler's stream and its file, empty if none, is returned for the
+     * caller to open.  Several are each written to their own file.
+     */
+    std::string add_outputs(const std::vector<std::string> & format_values, const std::vector<std::string> & filenames) {
+
+        std::vector<std::string> formats;
+        for(const std::string & value : format_values) {
+
+            std::string::size_type begin = 0;
+            while(begin <= value.size()) {
+
+                std::string::size_type end = std::min(value.find(',', begin), value.size());
+                if(end > begin)
+                    formats.push_back(value.substr(begin, end - begin));
+                begin = end + 1;
+
+            }
+
+        }
+
+        if(formats.size() <= 1 && filenames.size() <= 1) {
+
+            if(!formats.empty())
+                outputs.push_back(output_target{ formats.front(), "" });
+
+            return filenames.empty() ? std::string() : filenames.front();
+
+        }
+
+        if(formats.size() != filenames.size())
+            throw std::runtime_error("One output file is needed for each format");
+
+        for(std::size_t pos = 0; pos < formats.size(); ++pos)
+            outputs.push_back(output_target{ formats[pos], filenames[pos] });
+
+        return std::string();
+
+    }
+
+    /** settings that change what is parsed from a unit, a cache made with others is not used */
+    std::string get_parse_settings() const {
+
+        std::string settings = dependencies ? "bodies" : "no bodies";
+        for(const std::string & pattern : includes)
+            settings += "\ninclude " + pattern;
+        for(const std::string & pattern : excludes)
+            settings += "\nexclude " + pattern;
+
+        return settings;
+
+    }
+
+};
+
+#endif
@@ -0,0 +1,205 @@
+/**
+ * @file srcuml_output_buffer.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INCLUDED_SRCUML_OUTPUT_BUFFER_HPP
+#define INCLUDED_SRCUML_OUTPUT_BUFFER_HPP
+
+#include <ostream>
+#include <string>
+#include <cstring>
+#include <algorithm>
+
+/**
+ * srcuml_output_buffer
+ *
+ * Append-only text buffer in front of an ostream.  Text is collected and
+ * written with a single write per flush.  Appends never flush, so text
+ * appended since an offset can be rewritten, and commit() flushes at
+ * record boundaries once enough is buffered.  Without an ostream the
+ * text is only collected.
+ */
+class srcuml_output_buffer {
+
+private:
+
+    std::ostream * out;
+    std::string buffer;
+    std::size_t flush_size;
+
+public:
+
+    static const std::size_t DEFAULT_FLUSH_SIZE = 1 << 20;
+
+    explicit srcuml_output_buffer(std::ostream & out, std::size_t flush_size = DEFAULT_FLUSH_SIZE)
+        : out(&out),
+          buffer(),
+          flush_size(flush_size) {}
+
+    srcuml_output_buffer()
+        : out(nullptr),
+          buffer(),
+          flush_size(0) {}
+
+    ~srcuml_output_buffer() {
+        flush();
+    }
+
+    srcuml_output_buffer(const srcuml_output_buffer &) = delete;
+    srcuml_output_buffer & operator=(const srcuml_output_buffer &) = delete;
+
+    /** hint of the total size, capped so a flush's worth is allocated at most */
+    void reserve(std::size_t size) {
+
+        if(out) size = std::min(size, 2 * flush_size);
+        buffer.reserve(size);
+
+    }
+
+    std::size_t size() const {
+        return buffer.size();
+    }
+
+    /** buffered text, not yet written */
+    const std::string & str() const {
+        return buffer;
+    }
+
+    /** move the buffered text out, leaving the buffer empty */
+    std::string take() {
+
+        std::string text;
+        text.swap(buffer);
+        return text;
+
+    }
+
+    /** drop the buffered text after size */
+    void truncate(std::size_t size) {
+        buffer.resize(size);
+    }
+
+    srcuml_output_buffer & append(const char * data, std::size_t size) {
+
+        buffer.append(data, size);
+        return *this;
+
+    }
+
+    srcuml_output_buffer & append(const std::string & str) {
+
+        buffer.append(str);
+        return *this;
+
+    }
+
+    srcuml_output_buffer & put(char character) {
+
+        buffer.push_back(character);
+        return *this;
+
+    }
+
+    srcuml_output_buffer & append_number(unsigned long long number) {
+
+        char digits[20];
+        char * end = digits + sizeof(digits);
+        char * begin = end;
+        do {
+
+            *--begin = char('0' + number % 10);
+            number /= 10;
+
+        } while(number);
+
+        return append(begin, end - begin);
+
+    }
+
+    srcuml_output_buffer & append_number(long long number) {
+
+        if(number < 0) {
+
+            put('-');
+            return append_number(0ull - static_cast<unsigned long long>(number));
+
+        }
+
+        return append_number(static_cast<unsigned long long>(number));
+
+    }
+
+    /** write out the buffer once it reached the flush size, call between records */
+    void commit() {
+
+        if(out && buffer.size() >= flush_size)
+            flush();
+
+    }
+
+    void flush() {
+
+        if(!out || buffer.empty()) return;
+
+        out->write(buffer.data(), buffer.size());
+        buffer.clear();
+
+    }
+
+    friend srcuml_output_buffer & operator<<(srcuml_output_buffer & out, const std::string & str) {
+        return out.append(str);
+    }
+
+    friend srcuml_output_buffer & operator<<(srcuml_output_buffer & out, const char * str) {
+        return out.append(str, std::strlen(str));
+    }
+
+    friend srcuml_output_buffer & operator<<(srcuml_output_buffer & out, char character) {
+        return out.put(character);
+    }
+
+    friend srcuml_output_buffer & operator<<(srcuml_output_buffer & out, int number) {
+        return out.append_number(static_cast<long long>(number));
+    }
+
+    friend srcuml_output_buffer & operator<<(srcuml_output_buffer & out, long number) {
+        return out.append_number(static_cast<long long>(number));
+    }
+
+    friend srcuml_output_buffer & operator<<(srcuml_output_buffer & out, long long number) {
+        return out.append_number(number);
+    }
+
+    friend srcuml_output_buffer & operator<<(srcuml_output_buffer & out, unsigned int number) {
+        return out.append_number(static_cast<unsigned long long>(number));
+    }
+
+    friend srcuml_output_buffer & operator<<(srcuml_output_buffer & out, unsigned long number) {
+        return out.append_number(static_cast<unsigned long long>(number));
+    }
+
+    friend srcuml_output_buffer & operator<<(srcuml_output_buffer & out, unsigned long long number) {
+        return out.append_number(number);
+    }
+
+};
+
+#endif
@@ -24,15 +24,91 @@
 
 #include <srcuml_class.hpp>
 #include <srcuml_relationship.hpp>
+#include <srcuml_output_buffer.hpp>
+#include <srcuml_thread_pool.hpp>
 
 
 class srcuml_outputter {
 
+protected:
+
+	/** rough bytes per rendered class and relationship, to reserve the output buffer */
+	static const std::size_t CLASS_SIZE_HINT = 256;
+	static const std::size_t RELATIONSHIP_SIZE_HINT = 64;
+
+	/** items rendered per task when rendering in parallel */
+	static const std::size_t RENDER_CHUNK_SIZE = 512;
+
+	std::size_t jobs;
+
+	/**
+	 * Render count items in order.  With more than one job, chunks of items
+	 * are rendered into their own buffers a wave at a time, and the waves
+	 * are appended in item order, so the text is the same as a serial run.
+	 */
+	template<typename render_t>
+	void render(srcuml_thread_pool & pool, srcuml_output_buffer & out, std::size_t count, render_t render_item) {
+
+		if(pool.get_jobs() == 1 || count <= RENDER_CHUNK_SIZE) {
+
+			for(std::size_t item = 0; item < count; ++item) {
+
+				render_item(out, item);
+				out.commit();
+
+			}
+
+			return;
+
+		}
+
+		std::size_t chunk_count = (count + RENDER_CHUNK_SIZE - 1) / RENDER_CHUNK_SIZE;
+		std::size_t wave_size = pool.get_jobs() * 4;
+		std::vector<std::string> texts(std::min(wave_size, chunk_count));
+
+		for(std::size_t wave = 0; wave < chunk_count; wave += wave_size) {
+
+			std::size_t wave_chunks = std::min(wave_size, chunk_count - wave);
+			pool.parallel_for(wave_chunks, [&](std::size_t pos) {
+
+				std::size_t begin = (wave + pos) * RENDER_CHUNK_SIZE;
+				std::size_t end = std::min(begin + RENDER_CHUNK_SIZE, count);
+
+				srcuml_output_buffer chunk;
+				for(std::size_t item = begin; item < end; ++item)
+					render_item(chunk, item);
+				texts[pos] = chunk.take();
+
+			});
+
+			for(std::size_t pos = 0; pos < wave_chunks; ++pos) {
+
+				out.append(texts[pos]);
+				out.commit();
+
+			}
+
+		}
+
+	}
+
 public:
 
-	virtual bool output(std::ostream & out, std::vector<std::shared_ptr<srcuml_class>> & classes) = 0;
+	srcuml_outputter(std::size_t jobs = 1) : jobs(jobs) {}
+
+	virtual ~srcuml_outputter() {}
+
+	bool output(std::ostream & out, std::vector<srcuml_class *> & classes) {
+
+		srcuml_relationships relationships = analyze_relationships(classes);
+		return output(out, classes, relationships);
+
+	}
+
+	/** output classes whose relationships are already analyzed */
+	virtual bool output(std::ostream & out, std::vector<srcuml_class *> & classes, srcuml_relationships & relationships) = 0;
 
-	virtual srcuml_relationships analyze_relationships(std::vector<std::shared_ptr<srcuml_class>> & classes) {
+	virtual srcuml_relationships analyze_relationships(std::vector<srcuml_class *> & classes) {
 
 		return srcuml_relationships(classes);
 
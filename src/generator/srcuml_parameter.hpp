@@ -31,26 +31,40 @@ class srcuml_parameter {
 
 private:
 
-    const ParamTypePolicy::ParamTypeData * data;
-
     srcuml_type type;
     std::string name;
 
     bool is_pointer;
 
     bool has_index;
-    std::string index;
+    srcuml_symbol index;
 
 public:
     srcuml_parameter(const ParamTypePolicy::ParamTypeData * data)
-        : data(data),
-          type(data->type),
+        : type(data->type),
           name(data->name ? data->name->ToString() : ""),
           is_pointer(type.get_is_pointer()),
           has_index(false),
           index() {
 
-            analyze_parameter();
+            analyze_parameter(data);
+
+    }
+
+    srcuml_parameter(srcuml_binary_reader & reader)
+        : type(reader),
+          name(reader.read_string()),
+          is_pointer(reader.read_bool()),
+          has_index(reader.read_bool()),
+          index(reader.read_string()) {}
+
+    void write(srcuml_binary_writer & writer) const {
+
+        type.write(writer);
+        writer.write_string(name);
+        writer.write_bool(is_pointer);
+        writer.write_bool(has_index);
+        writer.write_string(index.get_string());
 
     }
 
@@ -69,7 +83,7 @@ public:
             std::string multiplicity = "［";
             if(is_pointer)
                 multiplicity += "0..";
-            multiplicity += index;
+            multiplicity += index.get_string();
             multiplicity += "］";
 
             return multiplicity;
@@ -90,10 +104,16 @@ public:
 
     }
 
-    // ~srcuml_parameter() { if(data) delete data; }
-
     friend std::ostream & operator<<(std::ostream & out, const srcuml_parameter & parameter) {
 
+        srcuml_output_buffer buffer(out);
+        buffer << parameter;
+        return out;
+
+    }
+
+    friend srcuml_output_buffer & operator<<(srcuml_output_buffer & out, const srcuml_parameter & parameter) {
+
         if(!parameter.type.get_is_const() && (parameter.type.get_is_pointer() || parameter.type.get_is_reference()))
             out << "inout ";
 
@@ -106,16 +126,16 @@ public:
     }
 
 private:
-    void analyze_parameter() {
+    void analyze_parameter(const ParamTypePolicy::ParamTypeData * data) {
 
         if(!data->name) return;
 
         if(!data->name->arrayIndices.empty()) {
             has_index = true;
-            index = data->name->arrayIndices[0];
+            index = srcuml_symbol(data->name->arrayIndices[0]);
         } else if(type.get_has_index()) {
             has_index = true;
-            index = type.get_index();
+            index = type.get_index_symbol();
         }
 
     }
@@ -0,0 +1,196 @@
+/**
+ * @file srcuml_reader.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDED_SRCUML_READER_HPP
+#define INCLUDED_SRCUML_READER_HPP
+
+#include <srcSAXController.hpp>
+
+#include <srcuml_markup.hpp>
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstring>
+
+/**
+ * srcuml_reader
+ *
+ * Feeds the SAX parser from a sequence of byte ranges through the
+ * controller's io callbacks.  The ranges are not copied and must outlive
+ * the parse, so a document can be stitched together from an archive
+ * header, a unit, and a footer without building it in memory.
+ *
+ * When function bodies are skipped, the contents of each function's
+ * <block> are left out of the ranges, so the parser never sees them.
+ * That includes classes defined inside a function body.
+ */
+class srcuml_reader {
+
+private:
+
+    std::vector<std::pair<const char *, std::size_t>> segments;
+
+    bool skip_bodies;
+
+    std::size_t segment;
+    std::size_t offset;
+
+public:
+
+    srcuml_reader(bool skip_bodies = false)
+        : segments(),
+          skip_bodies(skip_bodies),
+          segment(0),
+          offset(0) {}
+
+    srcuml_reader(const char * data, std::size_t size, bool skip_bodies = false)
+        : srcuml_reader(skip_bodies) {
+
+            add(data, size);
+
+    }
+
+    void add(const char * data, std::size_t size) {
+
+        if(skip_bodies)
+            add_without_bodies(data, size);
+        else
+            add_segment(data, size);
+
+    }
+
+    void add(const std::string & str) {
+        add(str.c_str(), str.size());
+    }
+
+    /** srcSAX read callback */
+    static int read(void * context, char * buffer, int len) {
+
+        srcuml_reader * reader = static_cast<srcuml_reader *>(context);
+
+        int count = 0;
+        while(count < len && reader->segment < reader->segments.size()) {
+
+            const std::pair<const char *, std::size_t> & current = reader->segments[reader->segment];
+            std::size_t amount = std::min<std::size_t>(len - count, current.second - reader->offset);
+
+            std::memcpy(buffer + count, current.first + reader->offset, amount);
+            count += amount;
+            reader->offset += amount;
+
+            if(reader->offset == current.second) {
+                ++reader->segment;
+                reader->offset = 0;
+            }
+
+        }
+
+        return count;
+
+    }
+
+    /** srcSAX close callback, the ranges are owned elsewhere */
+    static int close(void * context) {
+        return 0;
+    }
+
+private:
+
+    void add_segment(const char * data, std::size_t size) {
+
+        if(size)
+            segments.emplace_back(data, size);
+
+    }
+
+    static bool is_function(const srcuml_markup & markup, std::size_t pos) {
+
+        return markup.is_tag(pos, "function") || markup.is_tag(pos, "constructor") || markup.is_tag(pos, "destructor");
+
+    }
+
+    /**
+     * Add the ranges between function bodies, keeping the empty <block></block>.
+     * The body is the block that is a child of the function.  Blocks further
+     * in before it, e.g., of a lambda in a default argument, are emptied too.
+     */
+    void add_without_bodies(const char * data, std::size_t size) {
+
+        srcuml_markup markup(data, size);
+
+        std::size_t start = 0;
+        bool in_function = false;
+
+        /** elements open inside the function start tag */
+        std::size_t depth = 0;
+        for(std::size_t pos = markup.find_markup(0); pos < size; ) {
+
+            std::size_t tag_end = markup.find_tag_end(pos);
+
+            if(is_function(markup, pos + 1)) {
+
+                in_function = !markup.is_empty_tag(tag_end);
+                depth = 0;
+
+            } else if(pos + 1 < size && data[pos + 1] == '/' && is_function(markup, pos + 2)) {
+
+                in_function = false;
+
+            } else if(in_function && markup.is_tag(pos + 1, "block") && !markup.is_empty_tag(tag_end)) {
+
+                add_segment(data + start, tag_end - start);
+
+                start = markup.find_end_tag(tag_end, "block");
+                if(depth == 0) {
+
+                    tag_end = start;
+                    in_function = false;
+
+                } else {
+
+                    // the end tag is kept, but it closes a block that was not counted
+                    tag_end = markup.find_tag_end(start);
+
+                }
+
+            } else if(in_function && pos + 1 < size && data[pos + 1] == '/') {
+
+                --depth;
+
+            } else if(in_function && pos + 1 < size && data[pos + 1] != '!' && data[pos + 1] != '?' && !markup.is_empty_tag(tag_end)) {
+
+                ++depth;
+
+            }
+
+            pos = markup.find_markup(tag_end);
+
+        }
+
+        add_segment(data + start, size - start);
+
+    }
+
+};
+
+#endif
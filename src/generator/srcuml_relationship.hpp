@@ -19,273 +19,621 @@
  * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 #ifndef INCLUDED_SRCUML_RELATIONSHIP_HPP
 #define INCLUDED_SRCUML_RELATIONSHIP_HPP
 
 #include <srcuml_class.hpp>
+#include <srcuml_class_index.hpp>
+#include <srcuml_symbol.hpp>
+#include <srcuml_graph.hpp>
+#include <srcuml_thread_pool.hpp>
+
+#include <unordered_map>
+#include <memory>
+#include <array>
+#include <cstdint>
 
 enum relationship_type { DEPENDENCY, ASSOCIATION, BIDIRECTIONAL, AGGREGATION, COMPOSITION, GENERALIZATION, REALIZATION };
+/**
+ * srcuml_relationship
+ *
+ * An edge between two classes, identified by their node ids, i.e., their
+ * positions in the analyzed classes.  A dependency counts the uses it
+ * stands for, by where the type is used.
+ */
 struct srcuml_relationship {
 
-    srcuml_relationship(const std::string & source,
+    srcuml_relationship(std::uint32_t source_node,
                          const std::string & source_label,
-                         const std::string & destination,
+                         std::uint32_t destination_node,
                          const std::string & destination_label,
                          relationship_type type)
-        : source(source),
-          source_label(source_label),
-          destination(destination),
+        : source_label(source_label),
           destination_label(destination_label),
-          type(type) {}
+          type(type),
+          source_node(source_node),
+          destination_node(destination_node),
+          uses() {}
 
-    srcuml_relationship(const std::string & source,
-                         const std::string & destination,
+    srcuml_relationship(std::uint32_t source_node,
+                         std::uint32_t destination_node,
                          relationship_type type)
-        : srcuml_relationship(source, "", destination, "", type) {}
+        : source_label(),
+          destination_label(),
+          type(type),
+          source_node(source_node),
+          destination_node(destination_node),
+          uses() {}
+
+    srcuml_relationship(srcuml_binary_reader & reader)
+        : source_label(),
+          destination_label(),
+          type(DEPENDENCY),
+          source_node(0),
+          destination_node(0),
+          uses() {
+
+            source_node = reader.read_uint();
+            source_label = srcuml_symbol(reader.read_string());
+            destination_node = reader.read_uint();
+            destination_label = srcuml_symbol(reader.read_string());
+            type = (relationship_type)reader.read_uint();
+
+            for(std::uint32_t & count : uses)
+                count = reader.read_uint();
+
+    }
+
+    void write(srcuml_binary_writer & writer) const {
+
+        writer.write_uint(source_node);
+        writer.write_string(source_label.get_string());
+        writer.write_uint(destination_node);
+        writer.write_string(destination_label.get_string());
+        writer.write_uint(type);
+
+        for(std::uint32_t count : uses)
+            writer.write_uint(count);
+
+    }
 
-    std::string source;
-    std::string source_label;
-    std::string destination;
-    std::string destination_label;
+    srcuml_symbol source_label;
+    srcuml_symbol destination_label;
 
     relationship_type type;
 
-    std::string get_source() const{
-        return source;
+    std::uint32_t source_node;
+    std::uint32_t destination_node;
+
+    /** where a dependency's type is used */
+    enum use { PARAMETER_USE, LOCAL_USE, RETURN_USE };
+
+    std::array<std::uint32_t, 3> uses;
+
+    const std::string & get_source_label() const{
+        return source_label.get_string();
     }
 
-    std::string get_destination() const{
-        return destination;
+    const std::string & get_destination_label() const{
+        return destination_label.get_string();
     }
 
-    std::string get_source_label() const{
-        return source_label;
+    relationship_type get_type() const {
+        return type;
     }
 
-    std::string get_destination_label() const{
-        return destination_label;
+    std::uint32_t get_source_node() const {
+        return source_node;
     }
 
-    relationship_type get_type(){
-        return type;
+    std::uint32_t get_destination_node() const {
+        return destination_node;
+    }
+
+    std::uint32_t get_uses(use kind) const {
+        return uses[kind];
+    }
+
+    /** total uses of a dependency, 0 for other relationships */
+    std::uint32_t get_weight() const {
+        return uses[PARAMETER_USE] + uses[LOCAL_USE] + uses[RETURN_USE];
     }
 
 };
 
+/**
+ * srcuml_relationships
+ *
+ * Relationships between the classes.  Each class is a node whose id is
+ * its position in classes.  Type names are resolved to classes through a
+ * srcuml_class_index, so same named classes in different namespaces are
+ * distinct nodes.  The edges are kept in analysis order and indexed by a
+ * srcuml_graph for per node access.
+ *
+ * Inheritance is resolved in order, then the edges of each class are
+ * generated in parallel into per chunk buffers.  The buffers are merged
+ * in class order, so the edges are the same as a single threaded run.
+ */
 class srcuml_relationships {
 
 private:
 
-    std::vector<std::shared_ptr<srcuml_class>> & classes;
+    std::vector<srcuml_class *> & classes;
+
+    srcuml_class_index index;
+
+    struct generalization {
+
+        std::uint32_t parent;
+        std::uint32_t child;
+
+    };
 
-    std::map<std::string, std::shared_ptr<srcuml_class>> class_map;
+    /** resolved parents of each class, in class then parent order, and their adjacency */
+    std::vector<generalization> inheritance;
+    srcuml_graph hierarchy;
 
     std::vector<srcuml_relationship> relationships;
+    srcuml_graph graph;
+
+    bool dependencies;
+
+    /** classes per parallel work item */
+    static const std::size_t CHUNK_SIZE = 256;
+
+    /**
+     * Pure virtual functions a class has not implemented.  A class with a
+     * single parent points to the parent's set and keeps only the
+     * signatures it adds and overrides.  A class with several parents, or
+     * whose chain of sets gets deep, has them flattened into added, so a
+     * lookup walks only a few sets.
+     */
+    struct pure_virtual_set {
+
+        std::shared_ptr<const pure_virtual_set> inherited;
+        srcuml_signature_set added;
+        srcuml_signature_set overridden;
+
+        /** sets in the chain, including this one */
+        std::size_t depth;
+
+        /** functions not implemented */
+        std::size_t count;
+
+        bool contains(const srcuml_operation & function) const {
+
+            for(const pure_virtual_set * set = this; set; set = set->inherited.get()) {
+
+                if(set->added.contains(function)) return true;
+                if(set->overridden.contains(function)) return false;
+
+            }
+
+            return false;
+
+        }
+
+        /** insert every function not implemented into functions */
+        void collect(srcuml_signature_set & functions) const {
+
+            // a signature is decided by the nearest set that adds or overrides it
+            srcuml_signature_set decided;
+            for(const pure_virtual_set * set = this; set; set = set->inherited.get()) {
+
+                for(const srcuml_operation * function : set->added) {
+
+                    if(decided.contains(*function)) continue;
+
+                    functions.insert(function);
+                    decided.insert(function);
+
+                }
+
+                for(const srcuml_operation * function : set->overridden)
+                    decided.insert(function);
+
+            }
+
+        }
+
+    };
+
+    /** sets chained before the chain is flattened */
+    static const std::size_t MAX_SET_DEPTH = 8;
+
+    /** edges of a chunk of classes, by pass */
+    struct edge_buffer {
+
+        std::vector<srcuml_relationship> generalization_edges;
+        std::vector<srcuml_relationship> attribute_edges;
+        std::vector<srcuml_relationship> dependency_edges;
+
+    };
 
 public:
-    srcuml_relationships(std::vector<std::shared_ptr<srcuml_class>> & classes)
-        : classes(classes) {
-            analyze_classes();
+    /** @param jobs threads used to generate edges, 0 for all cores */
+    srcuml_relationships(std::vector<srcuml_class *> & classes, bool dependencies = true, std::size_t jobs = 1)
+        : classes(classes),
+          index(classes),
+          dependencies(dependencies) {
+            analyze_classes(jobs);
+    }
+
+    /** relationships that were already analyzed, e.g., read from a model file */
+    srcuml_relationships(std::vector<srcuml_class *> & classes, const std::vector<srcuml_relationship> & relationships)
+        : classes(classes),
+          index(classes),
+          relationships(),
+          dependencies(true) {
+
+            for(const srcuml_relationship & relationship : relationships)
+                add_relationship(relationship);
+            build_graph();
+
     }
 
     ~srcuml_relationships() {}
 
-    std::vector<srcuml_relationship> get_relationships(){
+    /** all edges in analysis order, the position is the edge id */
+    const std::vector<srcuml_relationship> & get_relationships() const {
         return relationships;
     }
 
+    const srcuml_relationship & get_relationship(std::uint32_t edge) const {
+        return relationships[edge];
+    }
+
+    const srcuml_graph & get_graph() const {
+        return graph;
+    }
+
+    srcuml_class * get_class(std::uint32_t node) const {
+        return classes[node];
+    }
+
+    const srcuml_class_index & get_index() const {
+        return index;
+    }
+
 private:
 
-    void analyze_classes() {
+    void analyze_classes(std::size_t jobs) {
 
-        generate_class_map();
+        resolve_parents();
         resolve_inheritence();
-        generate_attribute_relationships();
-        generate_dependency_relationships();
+        generate_relationships(jobs);
+        build_graph();
+
+    }
+
+    /** generate the edges of each class, the passes only read shared state */
+    void generate_relationships(std::size_t jobs) {
+
+        std::vector<edge_buffer> buffers((classes.size() + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+        srcuml_thread_pool pool(jobs);
+        pool.parallel_for(buffers.size(), [&](std::size_t chunk) {
+
+            edge_buffer & buffer = buffers[chunk];
+            std::size_t end = std::min(classes.size(), (chunk + 1) * CHUNK_SIZE);
+            for(std::uint32_t node = chunk * CHUNK_SIZE; node < end; ++node) {
+
+                generate_generalization_relationships(node, buffer.generalization_edges);
+                generate_attribute_relationships(node, buffer.attribute_edges);
+                if(dependencies)
+                    generate_dependency_relationships(node, buffer.dependency_edges);
+
+            }
+
+        });
+
+        // each pass over all classes before the next, as a serial run would
+        std::size_t count = 0;
+        for(const edge_buffer & buffer : buffers)
+            count += buffer.generalization_edges.size() + buffer.attribute_edges.size() + buffer.dependency_edges.size();
+        relationships.reserve(count);
+
+        for(std::vector<srcuml_relationship> edge_buffer::* edges
+                : { &edge_buffer::generalization_edges, &edge_buffer::attribute_edges, &edge_buffer::dependency_edges }) {
+
+            for(const edge_buffer & buffer : buffers)
+                relationships.insert(relationships.end(), (buffer.*edges).begin(), (buffer.*edges).end());
+
+        }
 
     }
 
+    /** only relationships between known classes are kept */
     void add_relationship(const srcuml_relationship & relationship) {
+
+        if(relationship.source_node >= classes.size() || relationship.destination_node >= classes.size()) return;
+
         relationships.emplace_back(relationship);
+
     }
 
-    void generate_class_map() {
+    void build_graph() {
 
-        for(const std::shared_ptr<srcuml_class> & aclass : classes) {
-            class_map[aclass->get_name()] = aclass;
-        } 
+        graph.build(classes.size(), relationships.size(),
+                    [this](std::size_t edge) { return relationships[edge].source_node; },
+                    [this](std::size_t edge) { return relationships[edge].destination_node; });
+
+    }
+
+    /** class named by type as seen from class node, NO_CLASS if none */
+    std::uint32_t resolve(std::uint32_t node, const srcuml_type & type) const {
+
+        return index.resolve(node, type.get_qualifier_symbol(), type.get_type_symbol());
 
     }
 
-    void resolve_inheritence_inner(std::shared_ptr<srcuml_class> & aclass) {
+    void resolve_parents() {
+
+        for(std::uint32_t node = 0; node < classes.size(); ++node) {
+
+            for(const srcuml_symbol & parent_name : classes[node]->get_parents()) {
+
+                std::uint32_t parent = index.resolve(node, parent_name.get_string());
+
+                /** @todo should I show these? */
+                if(parent != srcuml_class_index::NO_CLASS && parent != node)
+                    inheritance.push_back(generalization{ parent, node });
+
+            }
+
+        }
+
+        hierarchy.build(classes.size(), inheritance.size(),
+                        [this](std::size_t edge) { return inheritance[edge].parent; },
+                        [this](std::size_t edge) { return inheritance[edge].child; });
+
+    }
+
+    /**
+     * Classes with every parent before its children.  Classes on an
+     * inheritance cycle come last, in class order.
+     */
+    std::vector<std::uint32_t> inheritance_order() const {
+
+        std::vector<std::uint32_t> order;
+        order.reserve(classes.size());
+
+        std::vector<std::size_t> unresolved_parents(classes.size());
+        for(std::uint32_t node = 0; node < classes.size(); ++node) {
+
+            unresolved_parents[node] = hierarchy.get_in_edges(node).size();
+            if(unresolved_parents[node] == 0)
+                order.push_back(node);
 
+        }
+
+        for(std::size_t pos = 0; pos < order.size(); ++pos) {
+
+            for(std::uint32_t edge : hierarchy.get_out_edges(order[pos])) {
+
+                std::uint32_t child = inheritance[edge].child;
+                if(--unresolved_parents[child] == 0)
+                    order.push_back(child);
+
+            }
+
+        }
+
+        for(std::uint32_t node = 0; node < classes.size(); ++node) {
+            if(unresolved_parents[node] != 0)
+                order.push_back(node);
+        }
+
+        return order;
+
+    }
+
+    /**
+     * Pure virtual functions of a class that are still not implemented,
+     * i.e., its own and the inherited ones it does not override.  A class
+     * that adds and overrides nothing shares its parent's set, and one
+     * with a single parent only records what it changes, so the inherited
+     * functions are copied only to merge several parents.
+     */
+    std::shared_ptr<const pure_virtual_set> resolve_class(std::uint32_t node, const std::vector<std::shared_ptr<const pure_virtual_set>> & pure_virtual_sets) {
+
+        srcuml_class * aclass = classes[node];
+        const srcuml_signature_set & implemented = aclass->get_implemented_functions();
+        const srcuml_signature_set & own = aclass->get_pure_virtual_functions();
+
+        std::vector<std::shared_ptr<const pure_virtual_set>> parent_sets;
         bool has_found_parents = false;
-        for(const ClassPolicy::ParentData & parent_data : aclass->get_data().parents) {
+        for(std::uint32_t edge : hierarchy.get_in_edges(node)) {
 
-            std::map<std::string, std::shared_ptr<srcuml_class>>::iterator parent = class_map.find(parent_data.name);
+            std::uint32_t parent_node = inheritance[edge].parent;
+            has_found_parents = true;
 
-            if(parent != class_map.end()) {
+            if(!classes[parent_node]->get_is_interface()) {
+                aclass->set_is_interface(false);
+            }
 
-                has_found_parents = true;
+            // a parent on the same cycle is not resolved yet and adds nothing
+            const std::shared_ptr<const pure_virtual_set> & inherited = pure_virtual_sets[parent_node];
+            if(inherited && inherited->count != 0)
+                parent_sets.push_back(inherited);
 
-                if(!parent->second->get_is_finalized())
-                    resolve_inheritence_inner(parent->second);
+        }
 
-                if(!parent->second->get_is_interface()) {
-                    aclass->set_is_interface(false);
-                }
+        std::shared_ptr<const pure_virtual_set> pure_virtual_functions;
+        if(parent_sets.size() == 1) {
 
-                // add pure virtual from parents
-                for(const std::pair<std::string, const FunctionPolicy::FunctionData *> & function_pair
-                        : parent->second->get_pure_virtual_functions_map()) {
+            const std::shared_ptr<const pure_virtual_set> & inherited = parent_sets.front();
 
-                    std::map<std::string, const FunctionPolicy::FunctionData *>::const_iterator implemented_function
-                        = aclass->get_implemented_functions_map().find(function_pair.first);
-                    if(implemented_function == aclass->get_implemented_functions_map().end())
-                        aclass->get_pure_virtual_functions_map()[function_pair.first] = function_pair.second;
+            std::shared_ptr<pure_virtual_set> changed = std::make_shared<pure_virtual_set>();
+            changed->inherited = inherited;
+            changed->depth = inherited->depth + 1;
+            changed->count = inherited->count;
 
-                }
+            for(const srcuml_operation * function : implemented) {
+
+                if(!inherited->contains(*function)) continue;
+
+                changed->overridden.insert(function);
+                --changed->count;
 
-            } else {
-                /** @todo not sure what default shold be */
             }
-                
+
+            for(const srcuml_operation * function : own) {
+
+                if(!changed->overridden.contains(*function) && inherited->contains(*function)) continue;
+
+                changed->added.insert(function);
+                ++changed->count;
+
+            }
+
+            if(changed->added.empty() && changed->overridden.empty())
+                pure_virtual_functions = inherited;
+            else if(changed->depth > MAX_SET_DEPTH)
+                pure_virtual_functions = flatten(*changed);
+            else
+                pure_virtual_functions = changed;
+
+        } else if(!parent_sets.empty() || !own.empty()) {
+
+            std::shared_ptr<pure_virtual_set> merged = std::make_shared<pure_virtual_set>();
+            merged->depth = 1;
+            merged->added = own;
+
+            // add pure virtual from parents
+            srcuml_signature_set inherited;
+            for(const std::shared_ptr<const pure_virtual_set> & parent_set : parent_sets)
+                parent_set->collect(inherited);
+
+            for(const srcuml_operation * function : inherited) {
+
+                if(!implemented.contains(*function))
+                    merged->added.insert(function);
+
+            }
+
+            merged->count = merged->added.size();
+            pure_virtual_functions = merged;
+
+        } else {
+
+            static const std::shared_ptr<const pure_virtual_set> none = std::make_shared<pure_virtual_set>(pure_virtual_set{ nullptr, srcuml_signature_set(), srcuml_signature_set(), 1, 0 });
+            pure_virtual_functions = none;
+
         }
 
-        aclass->set_is_abstract(!aclass->get_pure_virtual_functions_map().empty());
+        aclass->set_is_abstract(pure_virtual_functions->count != 0);
         if(!has_found_parents
-            && aclass->get_implemented_functions_map().empty()
-            && aclass->get_pure_virtual_functions_map().empty())
+            && implemented.empty()
+            && own.empty())
             aclass->set_is_interface(false);
 
         // check if pure virtual are overriden
         aclass->set_is_finalized(true);
 
+        return pure_virtual_functions;
+
     }
 
-    void resolve_inheritence() {
+    /** a single set with the functions of a chain not implemented */
+    static std::shared_ptr<const pure_virtual_set> flatten(const pure_virtual_set & chain) {
 
-        for(std::pair<const std::string, std::shared_ptr<srcuml_class>> & map_pair : class_map) {
-            resolve_inheritence_inner(map_pair.second);
-        }
+        std::shared_ptr<pure_virtual_set> flat = std::make_shared<pure_virtual_set>();
+        flat->depth = 1;
+        chain.collect(flat->added);
+        flat->count = flat->added.size();
 
-        for(const std::shared_ptr<srcuml_class> & aclass : classes) {
+        return flat;
+
+    }
 
-            for(const ClassPolicy::ParentData & parent_data : aclass->get_data().parents) {
+    void resolve_inheritence() {
 
-                std::map<std::string, std::shared_ptr<srcuml_class>>::iterator parent = class_map.find(parent_data.name);
+        std::vector<std::shared_ptr<const pure_virtual_set>> pure_virtual_sets(classes.size());
+        for(std::uint32_t node : inheritance_order())
+            pure_virtual_sets[node] = resolve_class(node, pure_virtual_sets);
+ 
+    }
 
-                /** @todo should I show these? */
-                if(parent == class_map.end()) continue;
+    /** edges from each parent of the class, in parent order */
+    void generate_generalization_relationships(std::uint32_t node, std::vector<srcuml_relationship> & edges) const {
 
-                relationship_type type = GENERALIZATION;
-                if(!aclass->get_is_abstract() && parent->second->get_is_abstract()) {
-                    type = REALIZATION;
-                }
+        for(std::uint32_t edge : hierarchy.get_in_edges(node)) {
 
-                srcuml_relationship relationship(parent->second->get_srcuml_name(), aclass->get_srcuml_name(), type);
-                add_relationship(relationship);
+            std::uint32_t parent_node = inheritance[edge].parent;
 
+            relationship_type type = GENERALIZATION;
+            if(!classes[node]->get_is_abstract() && classes[parent_node]->get_is_abstract()) {
+                type = REALIZATION;
             }
 
+            edges.emplace_back(parent_node, node, type);
+
         }
- 
+
     }
 
-    void generate_attribute_relationships() {
+    void generate_attribute_relationships(std::uint32_t node, std::vector<srcuml_relationship> & edges) const {
 
-        for(const std::shared_ptr<srcuml_class> & aclass : classes) {
+        /** @todo may want set so same type not added twice */
 
-            /** @todo may want set so same type not added twice */
+        for(const srcuml_attribute & attribute : classes[node]->get_attributes()) {
 
-            for(const srcuml_attribute & attribute : aclass->get_attributes()) {
+            std::uint32_t related_node = resolve(node, attribute.get_type());
+            if(related_node == srcuml_class_index::NO_CLASS) continue;
 
-                std::map<std::string, std::shared_ptr<srcuml_class>>::iterator parent = class_map.find(attribute.get_type().get_type_name());
-                if(parent == class_map.end()) continue;
+            relationship_type type = ASSOCIATION;
+            if(attribute.get_type().get_is_composite())
+                type = COMPOSITION;
+            else if(attribute.get_type().get_is_aggregate())
+                type = AGGREGATION;
 
-                relationship_type type = ASSOCIATION;
-                if(attribute.get_type().get_is_composite())
-                    type = COMPOSITION;
-                else if(attribute.get_type().get_is_aggregate())
-                    type = AGGREGATION;
+            std::string relationship_label = attribute.get_name() + attribute.get_multiplicity();
+            edges.emplace_back(node, "", related_node, relationship_label, type);
 
-                std::string relationship_label = attribute.get_name() + attribute.get_multiplicity();
-                srcuml_relationship relationship(aclass->get_srcuml_name(), "", parent->second->get_srcuml_name(), relationship_label, type);
-                add_relationship(relationship);
+        }
 
-            }
+    }
 
-        }
+    /**
+     * Count a use of the class of type, if any, other than the class
+     * itself.  The first use adds the edge, later ones only count.
+     */
+    void add_dependency(std::uint32_t node, const srcuml_type & type, srcuml_relationship::use kind,
+                        std::unordered_map<std::uint32_t, std::size_t> & catalogued_dependencies,
+                        std::vector<srcuml_relationship> & edges) const {
+
+        std::uint32_t related_node = resolve(node, type);
+        if(related_node == srcuml_class_index::NO_CLASS || related_node == node)
+            return;
+
+        std::pair<std::unordered_map<std::uint32_t, std::size_t>::iterator, bool> catalogued
+            = catalogued_dependencies.emplace(related_node, edges.size());
+        if(catalogued.second)
+            edges.emplace_back(node, related_node, DEPENDENCY);
+
+        ++edges[catalogued.first->second].uses[kind];
 
     }
 
-    void generate_dependency_relationships(){//dependency is local variables or parameters
-        for(const std::shared_ptr<srcuml_class>& aclass : classes){
-            //create set of already add dependecies so no repeats
-            std::set<std::string> catalogued_dependencies;
-            //obtain current class type
-            std::string current_class_type = aclass->get_srcuml_name();
-            catalogued_dependencies.insert(current_class_type);
-
-            for(const std::pair<std::string, const FunctionPolicy::FunctionData *> func : aclass->get_implemented_functions_map()){
-                //Parameter dependencies
-                for(const ParamTypePolicy::ParamTypeData* aparam : func.second->parameters){
-                    //iterate over parameters
-                    //obtain param_type which is a nice string form of the type
-                    //==================================================
-                    srcuml_type* temp = new srcuml_type(aparam->type);
-                    std::string param_type = temp->get_type_name();
-                    //==================================================
-
-                    std::map<std::string, std::shared_ptr<srcuml_class>>::iterator related_class = class_map.find(param_type);
-                    if(related_class == class_map.end()) continue;
-                    std::string working_dep = related_class->second->get_srcuml_name();
-                    std::set<std::string>::iterator catalogued_class = catalogued_dependencies.find(working_dep);
-                    
-                    //remove last condition to re-add multi dependencies
-                    if(related_class == class_map.end() || current_class_type == working_dep )// || catalogued_class != catalogued_dependencies.end())
-                        continue;
-
-                    srcuml_relationship relationship(current_class_type, working_dep, DEPENDENCY);
-                    catalogued_dependencies.insert(working_dep); //add param_type is std::string 
-                    add_relationship(relationship);                   
-                }
-                //decleration dependencies   
-                for(const DeclTypePolicy::DeclTypeData* arelation : func.second->relations){
-                    srcuml_type* temp = new srcuml_type(arelation->type);
-                    std::string relate_type = temp->get_type_name();
-
-                    std::map<std::string, std::shared_ptr<srcuml_class>>::iterator related_class = class_map.find(relate_type);
-                    if(related_class == class_map.end()) continue;
-                    std::string working_dep = related_class->second->get_srcuml_name();//get heuristic version of dependency name
-                    std::set<std::string>::iterator catalogued_class = catalogued_dependencies.find(working_dep);
-
-                    //remove last condition to re-add multi dependencies
-                    if(related_class == class_map.end() || current_class_type == working_dep )// || catalogued_class != catalogued_dependencies.end())
-                        continue;
-
-                    srcuml_relationship relationship(current_class_type, working_dep, DEPENDENCY);
-                    catalogued_dependencies.insert(working_dep);
-                    add_relationship(relationship);
-                }
-                //Return type dependency
-                srcuml_type* temp = new srcuml_type(func.second->returnType);
-                std::string return_type = temp->get_type_name();
+    void generate_dependency_relationships(std::uint32_t node, std::vector<srcuml_relationship> & edges) const {//dependency is local variables or parameters
+        //edge of each class already depended on, so there is one per pair
+        std::unordered_map<std::uint32_t, std::size_t> catalogued_dependencies;
 
-                std::map<std::string, std::shared_ptr<srcuml_class>>::iterator related_class = class_map.find(return_type);
-                if(related_class == class_map.end()) continue;
-                std::string working_dep = related_class->second->get_srcuml_name();
-                std::set<std::string>::iterator catalogued_class = catalogued_dependencies.find(working_dep);
+        for(const srcuml_operation * func : classes[node]->get_implemented_functions()){
+            //Parameter dependencies
+            for(const srcuml_parameter & aparam : func->get_parameters())
+                add_dependency(node, aparam.get_type(), srcuml_relationship::PARAMETER_USE, catalogued_dependencies, edges);
 
-                //remove last condition to re-add multi dependencies
-                if(related_class == class_map.end() || current_class_type == working_dep )// || catalogued_class != catalogued_dependencies.end())
-                    continue;
+            //decleration dependencies   
+            for(const srcuml_type & local_type : func->get_local_types())
+                add_dependency(node, local_type, srcuml_relationship::LOCAL_USE, catalogued_dependencies, edges);
 
-                srcuml_relationship relationship(current_class_type, working_dep, DEPENDENCY);
-                catalogued_dependencies.insert(working_dep);
-                add_relationship(relationship);
-            } 
-        }
+            //Return type dependency
+            if(!func->get_has_return_type()) continue;
+            add_dependency(node, func->get_return_type(), srcuml_relationship::RETURN_USE, catalogued_dependencies, edges);
+        } 
     }
 
 };
@@ -0,0 +1,142 @@
+/**
+ * @file srcuml_signature_set.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INCLUDED_SRCUML_SIGNATURE_SET_HPP
+#define INCLUDED_SRCUML_SIGNATURE_SET_HPP
+
+#include <srcuml_operation.hpp>
+
+#include <vector>
+#include <cstdint>
+
+/**
+ * srcuml_signature_set
+ *
+ * Flat open addressing set of operations keyed by their signature hash.
+ * Operations with equal hashes are also compared signature by signature,
+ * so a hash collision never merges two different signatures.  Iteration
+ * is in insertion order.
+ */
+class srcuml_signature_set {
+
+private:
+
+    enum : std::uint32_t { EMPTY = 0xffffffff };
+
+    std::vector<const srcuml_operation *> operations;
+
+    /** indices into operations, a power of two in size */
+    std::vector<std::uint32_t> slots;
+
+public:
+
+    srcuml_signature_set()
+        : operations(),
+          slots() {}
+
+    typedef std::vector<const srcuml_operation *>::const_iterator const_iterator;
+
+    const_iterator begin() const {
+        return operations.begin();
+    }
+
+    const_iterator end() const {
+        return operations.end();
+    }
+
+    std::size_t size() const {
+        return operations.size();
+    }
+
+    bool empty() const {
+        return operations.empty();
+    }
+
+    /** add operation, replacing one with the same signature */
+    void insert(const srcuml_operation * operation) {
+
+        if((operations.size() + 1) * 4 > slots.size() * 3)
+            grow();
+
+        std::uint32_t & slot = find_slot(*operation);
+        if(slot == EMPTY) {
+
+            slot = static_cast<std::uint32_t>(operations.size());
+            operations.push_back(operation);
+
+        } else {
+
+            operations[slot] = operation;
+
+        }
+
+    }
+
+    /** operation with the same signature, nullptr if there is none */
+    const srcuml_operation * find(const srcuml_operation & operation) const {
+
+        if(slots.empty()) return nullptr;
+
+        std::uint32_t slot = const_cast<srcuml_signature_set *>(this)->find_slot(operation);
+        return slot == EMPTY ? nullptr : operations[slot];
+
+    }
+
+    bool contains(const srcuml_operation & operation) const {
+        return find(operation) != nullptr;
+    }
+
+private:
+
+    std::uint32_t & find_slot(const srcuml_operation & operation) {
+
+        const std::size_t mask = slots.size() - 1;
+        for(std::size_t pos = operation.get_signature_hash() & mask;; pos = (pos + 1) & mask) {
+
+            std::uint32_t & slot = slots[pos];
+            if(slot == EMPTY || operations[slot]->has_same_signature(operation))
+                return slot;
+
+        }
+
+    }
+
+    void grow() {
+
+        slots.assign(slots.empty() ? 8 : slots.size() * 2, EMPTY);
+
+        const std::size_t mask = slots.size() - 1;
+        for(std::uint32_t index = 0; index < operations.size(); ++index) {
+
+            std::size_t pos = operations[index]->get_signature_hash() & mask;
+            while(slots[pos] != EMPTY)
+                pos = (pos + 1) & mask;
+
+            slots[pos] = index;
+
+        }
+
+    }
+
+};
+
+#endif
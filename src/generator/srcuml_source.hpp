@@ -0,0 +1,195 @@
+/**
+ * @file srcuml_source.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDED_SRCUML_SOURCE_HPP
+#define INCLUDED_SRCUML_SOURCE_HPP
+
+#include <srcml.h>
+
+#include <string>
+#include <vector>
+#include <set>
+#include <utility>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include <sys/stat.h>
+#include <dirent.h>
+
+/**
+ * srcuml_source
+ *
+ * Source files to convert to srcML in memory with libsrcml.  Directories
+ * are searched recursively for files with an extension srcML knows, in
+ * sorted order so runs are repeatable.  Symbolic links are followed, but
+ * each directory is searched only once, so links back up the tree do not
+ * loop.
+ */
+class srcuml_source {
+
+private:
+
+    std::vector<std::string> files;
+
+    /** device and inode of the directories already searched */
+    std::set<std::pair<dev_t, ino_t>> directories;
+
+public:
+
+    srcuml_source(const std::vector<std::string> & paths)
+        : files(),
+          directories() {
+
+            for(const std::string & path : paths)
+                add_path(path, true);
+
+    }
+
+    std::size_t size() const {
+        return files.size();
+    }
+
+    const std::string & get_file(std::size_t pos) const {
+        return files[pos];
+    }
+
+    /** contents of a source file */
+    std::string read(std::size_t pos) const {
+
+        std::ifstream input(files[pos], std::ios::binary);
+        if(!input)
+            throw std::runtime_error("Unable to open source file: " + files[pos]);
+
+        return std::string(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+
+    }
+
+    /**
+     * Convert the contents of a file to a single unit srcML document in
+     * memory and call function(buffer, size) with it.  Each call uses its
+     * own libsrcml archive, so files can be converted on several threads.
+     */
+    template<typename function_t>
+    void convert(std::size_t pos, const std::string & contents, function_t function) const {
+
+        const std::string & filename = files[pos];
+
+        srcml_archive * archive = srcml_archive_create();
+
+        char * buffer = nullptr;
+        size_t size = 0;
+        srcml_archive_write_open_memory(archive, &buffer, &size);
+
+        srcml_unit * unit = srcml_unit_create(archive);
+        const char * language = srcml_archive_check_extension(archive, filename.c_str());
+        srcml_unit_set_language(unit, language ? language : "C++");
+        srcml_unit_set_filename(unit, filename.c_str());
+        int status = srcml_unit_parse_memory(unit, contents.c_str(), contents.size());
+
+        if(status == SRCML_STATUS_OK)
+            srcml_archive_write_unit(archive, unit);
+        srcml_unit_free(unit);
+
+        srcml_archive_close(archive);
+        srcml_archive_free(archive);
+
+        if(status != SRCML_STATUS_OK) {
+
+            srcml_memory_free(buffer);
+            throw std::runtime_error("Unable to convert source file: " + filename);
+
+        }
+
+        try {
+
+            function(static_cast<const char *>(buffer), static_cast<std::size_t>(size));
+
+        } catch(...) {
+
+            srcml_memory_free(buffer);
+            throw;
+
+        }
+
+        srcml_memory_free(buffer);
+
+    }
+
+private:
+
+    static bool has_language(const std::string & path) {
+
+        srcml_archive * archive = srcml_archive_create();
+        bool known = srcml_archive_check_extension(archive, path.c_str()) != nullptr;
+        srcml_archive_free(archive);
+
+        return known;
+
+    }
+
+    void add_path(const std::string & path, bool is_argument) {
+
+        struct stat path_stat;
+        if(stat(path.c_str(), &path_stat) != 0) {
+
+            // e.g., a dangling link found while searching a directory
+            if(!is_argument) return;
+            throw std::runtime_error("Unable to open input: " + path);
+
+        }
+
+        if(!S_ISDIR(path_stat.st_mode)) {
+
+            // files named explicitly are converted even without a known extension
+            if(is_argument || has_language(path))
+                files.push_back(path);
+            return;
+
+        }
+
+        if(!directories.insert(std::make_pair(path_stat.st_dev, path_stat.st_ino)).second) return;
+
+        DIR * dir = opendir(path.c_str());
+        if(!dir)
+            throw std::runtime_error("Unable to open directory: " + path);
+
+        std::vector<std::string> entries;
+        while(const struct dirent * entry = readdir(dir)) {
+
+            std::string name = entry->d_name;
+            if(name.empty() || name[0] == '.') continue;
+
+            entries.push_back(path.back() == '/' ? path + name : path + '/' + name);
+
+        }
+        closedir(dir);
+
+        std::sort(entries.begin(), entries.end());
+        for(const std::string & entry : entries)
+            add_path(entry, false);
+
+    }
+
+};
+
+#endif
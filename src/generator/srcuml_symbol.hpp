@@ -0,0 +1,223 @@
+/**
+ * @file srcuml_symbol.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INCLUDED_SRCUML_SYMBOL_HPP
+#define INCLUDED_SRCUML_SYMBOL_HPP
+
+#include <srcuml_output_buffer.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <functional>
+#include <ostream>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <stdexcept>
+#include <cstdint>
+
+/**
+ * srcuml_symbol_table
+ *
+ * Process-wide table of interned strings.  Every distinct string gets a
+ * stable integer id, and the string for an id never moves.  Interning is
+ * sharded by hash so parsing threads rarely wait on each other, and
+ * looking up the string for an id takes no lock.
+ */
+class srcuml_symbol_table {
+
+private:
+
+    static const std::size_t SHARD_COUNT = 16;
+    static const std::size_t BLOCK_BITS = 14;
+    static const std::size_t BLOCK_SIZE = std::size_t(1) << BLOCK_BITS;
+    static const std::size_t BLOCK_COUNT = std::size_t(1) << 14;
+
+    typedef std::atomic<const std::string *> slot;
+
+    struct shard {
+
+        std::mutex mutex;
+        std::unordered_map<std::string, std::uint32_t> ids;
+
+    };
+
+    shard shards[SHARD_COUNT];
+
+    std::mutex block_mutex;
+    std::atomic<slot *> blocks[BLOCK_COUNT];
+
+    std::atomic<std::uint32_t> next_id;
+
+    srcuml_symbol_table()
+        : next_id(0) {
+
+            for(std::atomic<slot *> & block : blocks)
+                block.store(nullptr, std::memory_order_relaxed);
+
+            // id 0 is the empty string
+            intern(std::string());
+
+    }
+
+public:
+
+    ~srcuml_symbol_table() {
+
+        for(std::atomic<slot *> & block : blocks)
+            delete[] block.load(std::memory_order_relaxed);
+
+    }
+
+    srcuml_symbol_table(const srcuml_symbol_table &) = delete;
+    srcuml_symbol_table & operator=(const srcuml_symbol_table &) = delete;
+
+    static srcuml_symbol_table & get_table() {
+
+        static srcuml_symbol_table table;
+        return table;
+
+    }
+
+    /** id of str, added to the table if it is new.  Safe to call from several threads. */
+    std::uint32_t intern(const std::string & str) {
+
+        shard & the_shard = shards[std::hash<std::string>()(str) % SHARD_COUNT];
+        std::lock_guard<std::mutex> lock(the_shard.mutex);
+
+        std::unordered_map<std::string, std::uint32_t>::const_iterator citr = the_shard.ids.find(str);
+        if(citr != the_shard.ids.end()) return citr->second;
+
+        std::uint32_t id = next_id++;
+        if(id >= BLOCK_SIZE * BLOCK_COUNT)
+            throw std::length_error("srcUML symbol table is full");
+
+        citr = the_shard.ids.emplace(str, id).first;
+        get_block(id >> BLOCK_BITS)[id & (BLOCK_SIZE - 1)].store(&citr->first, std::memory_order_release);
+
+        return id;
+
+    }
+
+    /** string for an id returned by intern */
+    const std::string & get_string(std::uint32_t id) const {
+
+        const slot * block = blocks[id >> BLOCK_BITS].load(std::memory_order_acquire);
+        return *block[id & (BLOCK_SIZE - 1)].load(std::memory_order_acquire);
+
+    }
+
+    std::size_t size() const {
+        return next_id.load();
+    }
+
+private:
+
+    slot * get_block(std::size_t pos) {
+
+        slot * block = blocks[pos].load(std::memory_order_acquire);
+        if(block) return block;
+
+        std::lock_guard<std::mutex> lock(block_mutex);
+        block = blocks[pos].load(std::memory_order_relaxed);
+        if(!block) {
+
+            block = new slot[BLOCK_SIZE];
+            blocks[pos].store(block, std::memory_order_release);
+
+        }
+
+        return block;
+
+    }
+
+};
+
+/**
+ * srcuml_symbol
+ *
+ * An interned string.  Symbols compare and hash as integers.  The
+ * default symbol is the empty string.
+ */
+class srcuml_symbol {
+
+private:
+
+    std::uint32_t id;
+
+public:
+
+    srcuml_symbol()
+        : id(0) {}
+
+    explicit srcuml_symbol(const std::string & str)
+        : id(srcuml_symbol_table::get_table().intern(str)) {}
+
+    std::uint32_t get_id() const {
+        return id;
+    }
+
+    const std::string & get_string() const {
+        return srcuml_symbol_table::get_table().get_string(id);
+    }
+
+    bool empty() const {
+        return id == 0;
+    }
+
+    bool operator==(const srcuml_symbol & other) const {
+        return id == other.id;
+    }
+
+    bool operator!=(const srcuml_symbol & other) const {
+        return id != other.id;
+    }
+
+    /** orders by id, not alphabetically */
+    bool operator<(const srcuml_symbol & other) const {
+        return id < other.id;
+    }
+
+    friend std::ostream & operator<<(std::ostream & out, const srcuml_symbol & symbol) {
+        return out << symbol.get_string();
+    }
+
+    friend srcuml_output_buffer & operator<<(srcuml_output_buffer & out, const srcuml_symbol & symbol) {
+        return out.append(symbol.get_string());
+    }
+
+};
+
+namespace std {
+
+template<>
+struct hash<srcuml_symbol> {
+
+    std::size_t operator()(const srcuml_symbol & symbol) const {
+        return symbol.get_id();
+    }
+
+};
+
+}
+
+#endif
@@ -0,0 +1,172 @@
+/**
+ * @file srcuml_thread_pool.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDED_SRCUML_THREAD_POOL_HPP
+#define INCLUDED_SRCUML_THREAD_POOL_HPP
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+/**
+ * srcuml_thread_pool
+ *
+ * Fixed set of worker threads.  parallel_for hands out indices one at a
+ * time, so long and short items balance across the workers.  The calling
+ * thread also takes part.
+ */
+class srcuml_thread_pool {
+
+private:
+
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<std::function<void()>> tasks;
+    bool stopping;
+
+public:
+
+    /** @param jobs total number of threads including the caller, 0 for all cores */
+    srcuml_thread_pool(std::size_t jobs)
+        : stopping(false) {
+
+            if(jobs == 0)
+                jobs = std::max(1u, std::thread::hardware_concurrency());
+
+            for(std::size_t count = 1; count < jobs; ++count)
+                workers.emplace_back(&srcuml_thread_pool::work, this);
+
+    }
+
+    ~srcuml_thread_pool() {
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        condition.notify_all();
+
+        for(std::thread & worker : workers)
+            worker.join();
+
+    }
+
+    srcuml_thread_pool(const srcuml_thread_pool &) = delete;
+    srcuml_thread_pool & operator=(const srcuml_thread_pool &) = delete;
+
+    std::size_t get_jobs() const {
+        return workers.size() + 1;
+    }
+
+    /**
+     * Call function(pos) for every pos in [0, count) and wait for all of them.
+     * The first exception thrown is rethrown here once every call finished.
+     */
+    template<typename function_t>
+    void parallel_for(std::size_t count, function_t function) {
+
+        std::atomic<std::size_t> next(0);
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        std::size_t running = std::min(workers.size(), count);
+        std::mutex done_mutex;
+        std::condition_variable done;
+
+        auto run = [&]() {
+
+            for(std::size_t pos = next++; pos < count; pos = next++) {
+
+                try {
+
+                    function(pos);
+
+                } catch(...) {
+
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if(!error) error = std::current_exception();
+
+                }
+
+            }
+
+        };
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for(std::size_t task = 0; task < running; ++task) {
+
+                tasks.emplace_back([&]() {
+
+                    run();
+
+                    std::lock_guard<std::mutex> lock(done_mutex);
+                    if(--running == 0) done.notify_one();
+
+                });
+
+            }
+        }
+        condition.notify_all();
+
+        run();
+
+        std::unique_lock<std::mutex> lock(done_mutex);
+        done.wait(lock, [&]() { return running == 0; });
+
+        if(error) std::rethrow_exception(error);
+
+    }
+
+private:
+
+    void work() {
+
+        while(true) {
+
+            std::function<void()> task;
+
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                if(tasks.empty()) return;
+
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+
+            task();
+
+        }
+
+    }
+
+};
+
+#endif
@@ -24,145 +24,214 @@
 
 #include <TypePolicySingleEvent.hpp>
 
-class srcuml_type {
-
-private:
+#include <srcuml_binary.hpp>
+#include <srcuml_symbol.hpp>
+#include <srcuml_type_registry.hpp>
 
-    std::shared_ptr<TypePolicy::TypeData> data;
+#include <array>
+#include <unordered_map>
+#include <utility>
 
-    std::string name;
-    bool is_numeric;
+/**
+ * srcuml_type
+ *
+ * A resolved type: its interned name, the namespace or class qualifier
+ * it was written with, its categories and modifiers in one flags word,
+ * and its interned array index.
+ */
+class srcuml_type {
 
-    bool is_pointer;
-    bool is_reference;
-    bool is_rvalue;
+private:
 
-    bool is_const;
+    /** modifier flags, above the srcuml::type_category bits */
+    enum modifier : std::uint32_t {
 
-    bool is_vector;
-    bool is_list;
-    bool is_deque;
-    bool is_forward_list;
-    bool is_stack;
-    bool is_queue;
-    bool is_priority_queue;
-    bool is_array;
+        POINTER   = 1u << 24,
+        REFERENCE = 1u << 25,
+        RVALUE    = 1u << 26,
+        CONST     = 1u << 27,
+        HAS_INDEX = 1u << 28
 
-    bool is_set;
-    bool is_map;
-    bool is_unordered_set;
-    bool is_unordered_map;
+    };
 
-    bool is_auto_ptr;
-    bool is_shared_ptr;
-    bool is_unique_ptr;
-    bool is_scoped_ptr;
+    static const std::uint32_t ORDERED = srcuml::VECTOR | srcuml::LIST | srcuml::DEQUE | srcuml::FORWARD_LIST
+                                       | srcuml::STACK | srcuml::QUEUE | srcuml::PRIORITY_QUEUE | srcuml::ARRAY;
+    static const std::uint32_t CONTAINER = ORDERED | srcuml::SET | srcuml::MAP | srcuml::UNORDERED_SET | srcuml::UNORDERED_MAP;
+    static const std::uint32_t SMART_POINTER = srcuml::AUTO_PTR | srcuml::SHARED_PTR | srcuml::UNIQUE_PTR | srcuml::SCOPED_PTR;
 
-    bool has_index;
-    std::string index;
+    srcuml_symbol name;
+    srcuml_symbol qualifier;
+    std::uint32_t flags;
+    srcuml_symbol index;
 
 public:
 
-    srcuml_type(TypePolicy::TypeData * data) : srcuml_type(std::shared_ptr<TypePolicy::TypeData>(data)) {}
+    srcuml_type()
+        : name(),
+          qualifier(),
+          flags(0),
+          index() {}
+
+    /**
+     * Only resolves data, policy data is not retained and may be freed.
+     * Types spelled the same way are resolved once per thread, keyed on
+     * the hash of their structure so no key text is built.
+     */
+    srcuml_type(const TypePolicy::TypeData * data) : srcuml_type() {
 
-    srcuml_type(std::shared_ptr<TypePolicy::TypeData> data)
-        : data(data),
-        name(),
-        is_numeric(false),
+            const std::uint64_t key = hash_key(data);
 
-        is_pointer(false),
-        is_reference(false),
-        is_rvalue(false),
+            resolution_cache & cache = get_cache();
+            if(cache.generation != srcuml_type_registry::get_registry().get_generation() || cache.types.size() >= MAX_CACHED_TYPES) {
 
-        is_const(false),
+                cache.types.clear();
+                cache.generation = srcuml_type_registry::get_registry().get_generation();
 
-        is_vector(false),
-        is_list(false),
-        is_deque(false),
-        is_forward_list(false),
-        is_stack(false),
-        is_queue(false),
-        is_priority_queue(false),
-        is_array(false),
+            }
 
-        is_set(false),
-        is_map(false),
-        is_unordered_set(false),
-        is_unordered_map(false),
+            std::unordered_map<std::uint64_t, srcuml_type>::const_iterator citr = cache.types.find(key);
+            if(citr != cache.types.end()) {
 
-        is_auto_ptr(false),
-        is_shared_ptr(false),
-        is_unique_ptr(false),
-        is_scoped_ptr(false),
+                *this = citr->second;
+                return;
 
-        has_index(false),
-        index() {
+            }
 
-            resolve_type();
+            resolve_type(data);
             check_is_numeric();
 
+            cache.types.emplace(key, *this);
+
     }
 
-    // ~srcuml_type() { delete data; }
+    srcuml_type(srcuml_binary_reader & reader)
+        : name(reader.read_string()),
+          qualifier(reader.read_string()),
+          flags(reader.read_uint()),
+          index(reader.read_string()) {}
+
+    void write(srcuml_binary_writer & writer) const {
+
+        writer.write_string(name.get_string());
+        writer.write_string(qualifier.get_string());
+        writer.write_uint(flags);
+        writer.write_string(index.get_string());
+
+    }
 
     const std::string & get_type_name() const {
-        return name;        
+        return name.get_string();
+    }
+
+    srcuml_symbol get_type_symbol() const {
+        return name;
+    }
+
+    /** qualifier written before the name, e.g., ns for ns::Foo, empty if none */
+    srcuml_symbol get_qualifier_symbol() const {
+        return qualifier;
+    }
+
+    /** a registered numeric type, output as number */
+    bool get_is_numeric() const {
+        return flags & srcuml::NUMERIC;
     }
 
     bool get_is_pointer() const {
-        return is_pointer;       
+        return flags & POINTER;
     }
 
     bool get_is_reference() const {
-        return is_reference;       
+        return flags & REFERENCE;
     }
 
     bool get_is_rvalue() const {
-        return is_rvalue;       
+        return flags & RVALUE;
     }
 
     bool get_is_const() const {
-        return is_const;       
+        return flags & CONST;
     }
 
     bool get_is_container() const {
-        return is_vector || is_list || is_deque || is_forward_list
-            || is_stack || is_queue || is_priority_queue || is_array
-            || is_set || is_map || is_unordered_set || is_unordered_map;
+        return flags & CONTAINER;
     }
 
     bool get_is_ordered() const {
-        return is_vector || is_list || is_deque || is_forward_list
-            || is_stack || is_queue || is_priority_queue || is_array;
+        return flags & ORDERED;
     }
 
     bool get_is_smart_pointer() const {
-        return is_auto_ptr || is_shared_ptr || is_unique_ptr || is_scoped_ptr;       
+        return flags & SMART_POINTER;
     }
 
     bool get_is_composite() const {
-        return (!is_pointer && !is_reference && !is_rvalue)
-            || is_shared_ptr;
+        return !(flags & (POINTER | REFERENCE | RVALUE))
+            || (flags & srcuml::SHARED_PTR);
             /** @todo unique_ptr? */
     }
 
     bool get_is_aggregate() const {
-        return is_pointer || is_reference || is_rvalue
-            || is_auto_ptr
-            || is_scoped_ptr;
+        return flags & (POINTER | REFERENCE | RVALUE | srcuml::AUTO_PTR | srcuml::SCOPED_PTR);
     }
 
     bool get_has_index() const {
-        return has_index;       
+        return flags & HAS_INDEX;
+    }
+
+    const std::string & get_index() const {
+        return index.get_string();
+    }
+
+    srcuml_symbol get_index_symbol() const {
+        return index;
     }
 
-    const std::string get_index() const {
-        return index;       
+    /**
+     * Hash the structure of a type, continuing from value: the kind of
+     * every part, names with their template arguments and array indices,
+     * and specifier and operator text.  This is everything resolve_type
+     * reads, so equal hashes resolve to equal types.
+     */
+    static std::uint64_t hash_key(const TypePolicy::TypeData * data, std::uint64_t value = srcuml::hash(nullptr, 0)) {
+
+        for(const std::pair<void *, TypePolicy::TypeType> & part : data->types) {
+
+            value = hash_token(static_cast<char>('A' + part.second), value);
+
+            if(part.second == TypePolicy::NAME)
+                value = hash_key(static_cast<const NamePolicy::NameData *>(part.first), value);
+            else if(part.second == TypePolicy::SPECIFIER)
+                value = hash_token(*static_cast<const std::string *>(part.first), value);
+
+        }
+
+        return value;
+
+    }
+
+    bool operator==(const srcuml_type & other) const {
+
+        return name == other.name && qualifier == other.qualifier
+            && flags == other.flags && index == other.index;
+
+    }
+
+    bool operator!=(const srcuml_type & other) const {
+        return !(*this == other);
     }
 
     friend std::ostream & operator<<(std::ostream & out, const srcuml_type & type) {
 
-        if(type.is_numeric)
+        srcuml_output_buffer buffer(out);
+        buffer << type;
+        return out;
+
+    }
+
+    friend srcuml_output_buffer & operator<<(srcuml_output_buffer & out, const srcuml_type & type) {
+
+        if(type.flags & srcuml::NUMERIC)
             out << "number";
         else
             out << type.name;
@@ -172,72 +241,91 @@ public:
     }
 
 private:
+
+    /** the cache is dropped when full, a run with more distinct types than this resolves some twice */
+    static const std::size_t MAX_CACHED_TYPES = 1 << 14;
+
+    struct resolution_cache {
+
+        std::size_t generation;
+        std::unordered_map<std::uint64_t, srcuml_type> types;
+
+    };
+
+    static resolution_cache & get_cache() {
+
+        thread_local resolution_cache cache{ 0, {} };
+        return cache;
+
+    }
+
+    static std::uint64_t hash_token(char token, std::uint64_t value) {
+        return srcuml::hash(&token, 1, value);
+    }
+
+    /** text is hashed with its terminator, so adjacent text stays apart */
+    static std::uint64_t hash_token(const std::string & token, std::uint64_t value) {
+        return srcuml::hash(token.c_str(), token.size() + 1, value);
+    }
+
+    static std::uint64_t hash_key(const NamePolicy::NameData * data, std::uint64_t value) {
+
+        value = hash_token(data->name, value);
+
+        value = hash_token('(', value);
+        for(const NamePolicy::NameData * name : data->names)
+            value = hash_key(name, value);
+        value = hash_token(')', value);
+
+        for(const TemplateArgumentPolicy::TemplateArgumentData * argument : data->templateArguments) {
+
+            value = hash_token('<', value);
+            for(const std::pair<void *, TemplateArgumentPolicy::TemplateArgumentType> & part : argument->data) {
+
+                value = hash_token(static_cast<char>('A' + part.second), value);
+
+                if(part.second == TemplateArgumentPolicy::NAME)
+                    value = hash_key(static_cast<const NamePolicy::NameData *>(part.first), value);
+                else if(part.second == TemplateArgumentPolicy::OPERATOR)
+                    value = hash_token(*static_cast<const std::string *>(part.first), value);
+
+            }
+            value = hash_token('>', value);
+
+        }
+
+        for(const std::string & index : data->arrayIndices)
+            value = hash_token(index, hash_token('[', value));
+
+        return value;
+
+    }
+
     void check_is_numeric() {
-        if(    name == "int"
-            || name == "double"
-            || name == "long"
-            || name == "size_t"
-            || name == "short"
-            || name == "float"
-            || name == "signed"
-            || name == "unsigned"
-          )
-            is_numeric = true;
+
+        flags |= srcuml_type_registry::get_registry().lookup(name.get_string()) & srcuml::NUMERIC;
 
     }
 
     void check_template_base(const std::string & name) {
 
-        if(name == "vector")
-            is_vector = true;
-        else if(name == "list")
-            is_list = true;
-        else if(name == "deque")
-            is_deque = true;
-        else if(name == "forward_list")
-            is_forward_list = true;
-        else if(name == "stack")
-            is_stack = true;
-        else if(name == "queue")
-            is_queue = true;
-        else if(name == "priority_queue")
-            is_priority_queue = true;
-        else if(name == "array")
-            is_array = true;
-
-        else if(name == "set")
-            is_set = true;
-        else if(name == "map")
-            is_map = true;
-        else if(name == "unordered_set")
-            is_unordered_set = true;
-        else if(name == "unordered_map")
-            is_unordered_map = true;
-
-        else if(name == "auto_ptr")
-            is_auto_ptr = true;
-        else if(name == "shared_ptr")
-            is_shared_ptr = true;
-        else if(name == "unique_ptr")
-            is_unique_ptr = true;
-        else if(name == "scoped_ptr")
-            is_scoped_ptr = true;
-
-    }
-
-    void resolve_type() {
+        flags |= srcuml_type_registry::get_registry().lookup(name) & srcuml::TEMPLATE_CATEGORIES;
+
+    }
+
+    void resolve_type(const TypePolicy::TypeData * data) {
 
         std::vector<std::pair<void *, TypePolicy::TypeType>>::const_reverse_iterator citr;
         for(citr = data->types.rbegin(); citr != data->types.rend(); ++citr) {
 
             if(citr->second == TypePolicy::POINTER)
-                is_pointer = true;
+                flags |= POINTER;
 
             if(citr->second == TypePolicy::REFERENCE)
-                is_reference = true;
+                flags |= REFERENCE;
 
             if(citr->second == TypePolicy::RVALUE)
-                is_rvalue = true;
+                flags |= RVALUE;
 
             if(citr->second != TypePolicy::NAME)
                 continue;
@@ -245,6 +333,7 @@ private:
             /** @todo need to look and see if using only last is valid */
             /** @todo issue in srcML to simplify markup, should make this simpler possibly eliminate if condition */
             const NamePolicy::NameData * type_name = static_cast<const NamePolicy::NameData *>(citr->first);
+            const NamePolicy::NameData * qualified_name = type_name;
             if(type_name->names.size() >= 2)
                 type_name = type_name->names.back();
 
@@ -253,16 +342,20 @@ private:
             /** @todo what if template argument is pointer? */
             if(type_name->templateArguments.empty()) {
                 type_str = type_name->SimpleName();
+                resolve_qualifier(qualified_name);
             } else {
                 check_template_base(type_name->SimpleName());
                 type_str = resolve_template_type(type_name);
             }
 
-            has_index = !type_name->arrayIndices.empty();
-            if(has_index)
-                index = type_name->arrayIndices[0];
+            if(!type_name->arrayIndices.empty()) {
+
+                flags |= HAS_INDEX;
+                index = srcuml_symbol(type_name->arrayIndices[0]);
+
+            }
 
-            name = type_str;
+            name = srcuml_symbol(type_str);
             break;
 
         }
@@ -276,7 +369,7 @@ private:
 
             if(specifier == "const") {
 
-                is_const = true;
+                flags |= CONST;
                 break;
 
             }
@@ -286,27 +379,52 @@ private:
 
     }
 
+    /** the names before the last one, joined with :: */
+    void resolve_qualifier(const NamePolicy::NameData * type_name) {
+
+        if(type_name->names.size() < 2) return;
+
+        std::string qualifier_str;
+        for(std::size_t pos = 0; pos + 1 < type_name->names.size(); ++pos) {
+
+            std::string part = type_name->names[pos]->SimpleName();
+            if(part.empty()) continue;
+
+            if(!qualifier_str.empty())
+                qualifier_str += "::";
+            qualifier_str += part;
+
+        }
+
+        qualifier = srcuml_symbol(qualifier_str);
+
+    }
+
     std::string resolve_template_type(const NamePolicy::NameData * type_name) {
 
-        if(type_name->templateArguments.empty())
+        if(type_name->templateArguments.empty()) {
+
+            resolve_qualifier(type_name);
             return type_name->SimpleName();
 
+        }
+
         /** @todo need to look and see if using only last is valid */
         for(std::vector<std::pair<void *, TemplateArgumentPolicy::TemplateArgumentType>>::const_reverse_iterator citr = type_name->templateArguments.back()->data.rbegin();
             citr != type_name->templateArguments.back()->data.rend();
             ++citr) {
 
             if(citr->second == TemplateArgumentPolicy::POINTER)
-                is_pointer = true;
+                flags |= POINTER;
 
             if(citr->second == TemplateArgumentPolicy::OPERATOR && (*static_cast<std::string *>(citr->first)) == "*")
-                is_pointer = true;
+                flags |= POINTER;
 
             if(citr->second == TemplateArgumentPolicy::REFERENCE)
-                is_reference = true;
+                flags |= REFERENCE;
 
             if(citr->second == TemplateArgumentPolicy::RVALUE)
-                is_rvalue = true;
+                flags |= RVALUE;
 
             if(citr->second != TemplateArgumentPolicy::NAME)
                 continue;
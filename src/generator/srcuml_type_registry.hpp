@@ -0,0 +1,297 @@
+/**
+ * @file srcuml_type_registry.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INCLUDED_SRCUML_TYPE_REGISTRY_HPP
+#define INCLUDED_SRCUML_TYPE_REGISTRY_HPP
+
+#include <srcuml_utilities.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <map>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+
+namespace srcuml {
+
+/** categories of a type name, combined as a bitmask */
+enum type_category : std::uint32_t {
+
+    NONE           = 0,
+    NUMERIC        = 1 << 0,
+
+    VECTOR         = 1 << 1,
+    LIST           = 1 << 2,
+    DEQUE          = 1 << 3,
+    FORWARD_LIST   = 1 << 4,
+    STACK          = 1 << 5,
+    QUEUE          = 1 << 6,
+    PRIORITY_QUEUE = 1 << 7,
+    ARRAY          = 1 << 8,
+
+    SET            = 1 << 9,
+    MAP            = 1 << 10,
+    UNORDERED_SET  = 1 << 11,
+    UNORDERED_MAP  = 1 << 12,
+
+    AUTO_PTR       = 1 << 13,
+    SHARED_PTR     = 1 << 14,
+    UNIQUE_PTR     = 1 << 15,
+    SCOPED_PTR     = 1 << 16
+
+};
+
+/** categories that come from a template's name */
+const std::uint32_t TEMPLATE_CATEGORIES = ~std::uint32_t(NUMERIC);
+
+namespace type_registry {
+
+struct entry {
+
+    const char * name;
+    std::uint32_t categories;
+
+};
+
+constexpr entry builtins[] = {
+
+    { "int", NUMERIC }, { "double", NUMERIC }, { "long", NUMERIC }, { "size_t", NUMERIC },
+    { "short", NUMERIC }, { "float", NUMERIC }, { "signed", NUMERIC }, { "unsigned", NUMERIC },
+
+    { "vector", VECTOR }, { "list", LIST }, { "deque", DEQUE }, { "forward_list", FORWARD_LIST },
+    { "stack", STACK }, { "queue", QUEUE }, { "priority_queue", PRIORITY_QUEUE }, { "array", ARRAY },
+
+    { "set", SET }, { "map", MAP }, { "unordered_set", UNORDERED_SET }, { "unordered_map", UNORDERED_MAP },
+
+    { "auto_ptr", AUTO_PTR }, { "shared_ptr", SHARED_PTR }, { "unique_ptr", UNIQUE_PTR }, { "scoped_ptr", SCOPED_PTR }
+
+};
+
+constexpr std::size_t BUILTIN_COUNT = sizeof(builtins) / sizeof(builtins[0]);
+constexpr std::size_t TABLE_SIZE = 128;
+
+struct table {
+
+    std::uint32_t seed;
+    std::int8_t slots[TABLE_SIZE];
+
+};
+
+constexpr std::size_t length(const char * str) {
+
+    std::size_t size = 0;
+    while(str[size]) ++size;
+    return size;
+
+}
+
+constexpr std::uint32_t hash(const char * str, std::size_t size, std::uint32_t seed) {
+
+    std::uint32_t value = 2166136261u ^ seed;
+    for(std::size_t pos = 0; pos < size; ++pos) {
+
+        value ^= static_cast<unsigned char>(str[pos]);
+        value *= 16777619u;
+
+    }
+
+    return value;
+
+}
+
+/** find the first seed that puts every built-in name in its own slot */
+constexpr table build_table() {
+
+    for(std::uint32_t seed = 0; ; ++seed) {
+
+        table result{ seed, {} };
+        for(std::size_t pos = 0; pos < TABLE_SIZE; ++pos)
+            result.slots[pos] = -1;
+
+        bool is_perfect = true;
+        for(std::size_t pos = 0; is_perfect && pos < BUILTIN_COUNT; ++pos) {
+
+            std::size_t slot = hash(builtins[pos].name, length(builtins[pos].name), seed) % TABLE_SIZE;
+            is_perfect = result.slots[slot] == -1;
+            result.slots[slot] = static_cast<std::int8_t>(pos);
+
+        }
+
+        if(is_perfect) return result;
+
+    }
+
+}
+
+constexpr table builtin_table = build_table();
+
+}
+
+}
+
+/**
+ * srcuml_type_registry
+ *
+ * Maps type names to the categories srcUML cares about (numbers,
+ * containers, smart pointers).  Built-in names are found with a perfect
+ * hash generated at compile time: one hash and one compare per lookup.
+ * More names can be registered at startup, before any parsing, e.g.,
+ * from a --type-config file.  Each handler resets the registry before
+ * it registers its own, so names do not carry over to the next run.
+ *
+ * Names are unqualified, as srcuml_type sees them, so absl::flat_hash_map
+ * is registered as flat_hash_map.
+ */
+class srcuml_type_registry {
+
+private:
+
+    std::unordered_map<std::string, std::uint32_t> extensions;
+    std::size_t generation;
+
+    srcuml_type_registry()
+        : extensions(),
+          generation(0) {}
+
+public:
+
+    srcuml_type_registry(const srcuml_type_registry &) = delete;
+    srcuml_type_registry & operator=(const srcuml_type_registry &) = delete;
+
+    static srcuml_type_registry & get_registry() {
+
+        static srcuml_type_registry registry;
+        return registry;
+
+    }
+
+    /** categories of the unqualified type name, NONE if unknown */
+    std::uint32_t lookup(const std::string & name) const {
+
+        using namespace srcuml::type_registry;
+
+        std::int8_t pos = builtin_table.slots[hash(name.c_str(), name.size(), builtin_table.seed) % TABLE_SIZE];
+        if(pos >= 0 && std::strcmp(builtins[pos].name, name.c_str()) == 0)
+            return builtins[pos].categories;
+
+        if(extensions.empty()) return srcuml::NONE;
+
+        std::unordered_map<std::string, std::uint32_t>::const_iterator citr = extensions.find(name);
+        return citr == extensions.end() ? srcuml::NONE : citr->second;
+
+    }
+
+    /** register a name, a qualified name is registered by its last part */
+    void add(const std::string & name, std::uint32_t categories) {
+
+        std::string::size_type scope = name.rfind("::");
+        std::string simple_name = scope == std::string::npos ? name : name.substr(scope + 2);
+
+        std::uint32_t & registered = extensions[simple_name];
+        registered = lookup(simple_name) | categories;
+        ++generation;
+
+    }
+
+    /** drop the registered names, leaving only the built-in ones */
+    void reset() {
+
+        if(extensions.empty()) return;
+
+        extensions.clear();
+        ++generation;
+
+    }
+
+    /** changes whenever a name is registered or dropped, so cached lookups can be dropped */
+    std::size_t get_generation() const {
+        return generation;
+    }
+
+    /**
+     * Register the names in a config file.  Each line is a category and
+     * a name, e.g., "unordered_map absl::flat_hash_map".  Blank lines and
+     * lines starting with '#' are skipped.
+     */
+    void load(const std::string & filename) {
+
+        std::ifstream config(filename);
+        if(!config)
+            throw std::runtime_error("Unable to open type config: " + filename);
+
+        std::string line;
+        for(std::size_t line_number = 1; std::getline(config, line); ++line_number) {
+
+            srcuml::trim(line);
+            if(line.empty() || line[0] == '#') continue;
+
+            std::istringstream fields(line);
+            std::string category_name, name, extra;
+            fields >> category_name >> name;
+            if(name.empty() || (fields >> extra))
+                throw std::runtime_error(filename + ":" + std::to_string(line_number) + ": expected a category and a type name");
+
+            std::uint32_t categories = get_category(category_name);
+            if(categories == srcuml::NONE)
+                throw std::runtime_error(filename + ":" + std::to_string(line_number) + ": unknown type category " + category_name);
+
+            add(name, categories);
+
+        }
+
+    }
+
+    /** registered names and categories in a stable order, for detecting a changed registry */
+    std::string get_settings() const {
+
+        std::map<std::string, std::uint32_t> sorted(extensions.begin(), extensions.end());
+
+        std::string settings;
+        for(const std::pair<const std::string, std::uint32_t> & extension : sorted)
+            settings += extension.first + ' ' + std::to_string(extension.second) + '\n';
+
+        return settings;
+
+    }
+
+    /** category for a name such as unordered_map or numeric, NONE if there is none */
+    static std::uint32_t get_category(const std::string & category_name) {
+
+        using namespace srcuml::type_registry;
+
+        if(category_name == "numeric") return srcuml::NUMERIC;
+
+        for(std::size_t pos = 0; pos < BUILTIN_COUNT; ++pos)
+            if(builtins[pos].categories != srcuml::NUMERIC && category_name == builtins[pos].name)
+                return builtins[pos].categories;
+
+        return srcuml::NONE;
+
+    }
+
+};
+
+
+#endif
@@ -35,4 +35,17 @@ std::string & trim(std::string & str) {
 
 }
 
+std::uint64_t hash(const char * data, std::size_t size, std::uint64_t value) {
+
+    for(std::size_t pos = 0; pos < size; ++pos) {
+
+        value ^= static_cast<unsigned char>(data[pos]);
+        value *= 0x100000001b3ULL;
+
+    }
+
+    return value;
+
+}
+
 }
@@ -23,11 +23,15 @@
 #define INCLUDED_SRCUML_UTILITIES_HPP
 
 #include <string>
+#include <cstdint>
 
 namespace srcuml {
 
 std::string & trim(std::string & str);
 
+/** 64-bit FNV-1a hash, used to detect changed content, continues from value to hash in parts */
+std::uint64_t hash(const char * data, std::size_t size, std::uint64_t value = 0xcbf29ce484222325ULL);
+
 }
 
 #endif
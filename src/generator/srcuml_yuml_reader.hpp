@@ -0,0 +1,294 @@
+/**
+ * @file srcuml_yuml_reader.hpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INCLUDED_SRCUML_YUML_READER_HPP
+#define INCLUDED_SRCUML_YUML_READER_HPP
+
+#include <srcuml_relationship.hpp>
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <stdexcept>
+#include <cstdint>
+
+/**
+ * srcuml_yuml_reader
+ *
+ * Reads a yUML class diagram, as written by yuml_outputter, into nodes
+ * and the srcuml_relationships between them.  The text is scanned once
+ * with a hand-written scanner.  A box on a line of its own defines a
+ * node, a box in a relationship refers to the first node of that name
+ * and only defines one if there is none, so node ids match the class
+ * positions of the diagram that was written.
+ */
+class srcuml_yuml_reader {
+
+public:
+
+    /** a class box, members are the rendered text between the separators */
+    struct node {
+
+        std::string name;
+
+        bool has_field;
+        bool has_method;
+
+        std::vector<std::string> attributes;
+        std::vector<std::string> operations;
+
+    };
+
+private:
+
+    std::vector<node> nodes;
+    std::vector<srcuml_relationship> relationships;
+
+    std::unordered_map<std::string, std::uint32_t> node_ids;
+
+    const char * pos;
+    const char * end;
+    std::size_t line;
+
+public:
+
+    srcuml_yuml_reader(const char * data, std::size_t size)
+        : nodes(),
+          relationships(),
+          node_ids(),
+          pos(data),
+          end(data + size),
+          line(1) {
+
+            read();
+
+    }
+
+    const std::vector<node> & get_nodes() const {
+        return nodes;
+    }
+
+    /** edges in diagram order between node ids */
+    const std::vector<srcuml_relationship> & get_relationships() const {
+        return relationships;
+    }
+
+private:
+
+    /** each line is a box, or a relationship of a box, a relation, and a box */
+    void read() {
+
+        while(true) {
+
+            skip_space();
+            if(pos == end) return;
+
+            node source = read_box();
+
+            skip_blank();
+            if(pos == end || *pos == '\n') {
+
+                add_node(std::move(source));
+                continue;
+
+            }
+
+            std::uint32_t source_node = find_node(std::move(source));
+
+            const char * relation = pos;
+            while(pos != end && *pos != '[' && *pos != '\n')
+                ++pos;
+            if(pos == end || *pos != '[')
+                error("expected a box after the relation");
+
+            const char * relation_end = pos;
+            while(relation_end != relation && is_blank(relation_end[-1]))
+                --relation_end;
+
+            std::uint32_t destination_node = find_node(read_box());
+            read_relation(relation, relation_end, source_node, destination_node);
+
+        }
+
+    }
+
+    /**
+     * The relation is source label, arrow, destination label, where the
+     * arrow is one of -, <-, <>-, ++-, -.-, ^-, or ^-.-, followed by > for
+     * all but generalizations.  Labels cannot contain -, so the first -
+     * locates the arrow.
+     */
+    void read_relation(const char * begin, const char * finish, std::uint32_t source_node, std::uint32_t destination_node) {
+
+        const char * dash = begin;
+        while(dash != finish && *dash != '-')
+            ++dash;
+        if(dash == finish)
+            error("expected a relation");
+
+        relationship_type type = ASSOCIATION;
+        const char * label_end = dash;
+        const char * after = dash + 1;
+        bool dashed = finish - after >= 2 && after[0] == '.' && after[1] == '-';
+
+        if(dash - begin >= 2 && dash[-2] == '<' && dash[-1] == '>') {
+
+            type = AGGREGATION;
+            label_end = dash - 2;
+
+        } else if(dash - begin >= 2 && dash[-2] == '+' && dash[-1] == '+') {
+
+            type = COMPOSITION;
+            label_end = dash - 2;
+
+        } else if(dash != begin && dash[-1] == '^') {
+
+            type = dashed ? REALIZATION : GENERALIZATION;
+            label_end = dash - 1;
+
+        } else if(dashed) {
+
+            type = DEPENDENCY;
+
+        }
+
+        if(dashed)
+            after += 2;
+
+        const char * label_begin = begin;
+        if(type == ASSOCIATION && label_begin != label_end && *label_begin == '<') {
+
+            type = BIDIRECTIONAL;
+            ++label_begin;
+
+        }
+
+        const char * destination_label_end = finish;
+        if(destination_label_end != after && destination_label_end[-1] == '>')
+            --destination_label_end;
+
+        relationships.emplace_back(source_node, std::string(label_begin, label_end),
+                                   destination_node, std::string(after, destination_label_end), type);
+
+    }
+
+    /** [name], [name|attributes], or [name|attributes|operations], members end with ; */
+    node read_box() {
+
+        if(pos == end || *pos != '[')
+            error("expected [ at the start of the box");
+        ++pos;
+
+        const char * name = pos;
+        while(pos != end && *pos != '|' && *pos != ']' && *pos != '\n')
+            ++pos;
+        const char * name_end = pos;
+
+        node box{ std::string(name, name_end), false, false, {}, {} };
+
+        if(pos != end && *pos == '|') {
+
+            box.has_field = true;
+            read_members(box.attributes);
+
+        }
+
+        if(pos != end && *pos == '|') {
+
+            box.has_method = true;
+            read_members(box.operations);
+
+        }
+
+        if(pos == end || *pos != ']')
+            error("expected ] at the end of the box");
+        ++pos;
+
+        return box;
+
+    }
+
+    void read_members(std::vector<std::string> & members) {
+
+        ++pos;
+        const char * member = pos;
+        for(; pos != end && *pos != '|' && *pos != ']' && *pos != '\n'; ++pos) {
+
+            if(*pos != ';') continue;
+
+            members.emplace_back(member, pos);
+            member = pos + 1;
+
+        }
+
+        if(member != pos)
+            members.emplace_back(member, pos);
+
+    }
+
+    std::uint32_t add_node(node && box) {
+
+        std::uint32_t id = nodes.size();
+        node_ids.emplace(box.name, id);
+        nodes.push_back(std::move(box));
+
+        return id;
+
+    }
+
+    /** the first node of the box's name, the box defines one if there is none */
+    std::uint32_t find_node(node && box) {
+
+        std::unordered_map<std::string, std::uint32_t>::const_iterator found = node_ids.find(box.name);
+        if(found != node_ids.end())
+            return found->second;
+
+        return add_node(std::move(box));
+
+    }
+
+    void skip_space() {
+
+        for(; pos != end && (is_blank(*pos) || *pos == '\n'); ++pos)
+            if(*pos == '\n') ++line;
+
+    }
+
+    void skip_blank() {
+
+        while(pos != end && is_blank(*pos))
+            ++pos;
+
+    }
+
+    static bool is_blank(char character) {
+        return character == ' ' || character == '\t' || character == '\r';
+    }
+
+    void error(const char * message) const {
+        throw std::runtime_error("Invalid yUML on line " + std::to_string(line) + ": " + message);
+    }
+
+};
+
+#endif
@@ -22,9 +22,10 @@
 #ifndef INCLUDED_STATIC_OUTPUTTER_HPP
 #define INCLUDED_STATIC_OUTPUTTER_HPP
 
+#include <srcuml_output_buffer.hpp>
+
 #include <string>
 #include <ostream>
-#include <sstream>
 
 #define COMBINING_LOW_LINE "\u0332"
 class static_outputter {
@@ -40,22 +41,26 @@ public:
         return 1;
     }
 
+    /** output t underlined, i.e., with a combining low line after each character */
     template <typename T>
-    static std::ostream & output(std::ostream & out, const T & t) {
+    static srcuml_output_buffer & output(srcuml_output_buffer & out, const T & t) {
 
-        std::ostringstream str_out;
-        str_out << t;
+        // render in place, then rewrite the rendered text a character at a time
+        std::size_t begin = out.size();
+        out << t;
+
+        thread_local std::string str;
+        str.assign(out.str(), begin, std::string::npos);
+        out.truncate(begin);
 
-        const std::string & str = str_out.str();
         std::size_t size = str.size();
         for(std::size_t pos = 0; pos < size;) {
 
-            std::size_t num_bytes = num_utf_bytes(str[pos]);
-
-            while(num_bytes--)
-               out << str[pos++];
+            std::size_t num_bytes = std::min(num_utf_bytes(str[pos]), size - pos);
 
-            out << COMBINING_LOW_LINE;
+            out.append(str.data() + pos, num_bytes);
+            out.append(COMBINING_LOW_LINE, sizeof(COMBINING_LOW_LINE) - 1);
+            pos += num_bytes;
 
         }
 
@@ -63,28 +68,16 @@ public:
 
     }
 
-};
-
-
-template <>
-std::ostream & static_outputter::output<std::string>(std::ostream & out, const std::string & t) {
-
-    const std::string & str = t;
-    std::size_t size = str.size();
-    for(std::size_t pos = 0; pos < size;) {
-
-        std::size_t num_bytes = static_outputter::num_utf_bytes(str[pos]);
-
-        while(num_bytes--)
-           out << str[pos++];
+    template <typename T>
+    static std::ostream & output(std::ostream & out, const T & t) {
 
-        out << COMBINING_LOW_LINE;
+        srcuml_output_buffer buffer(out);
+        output(buffer, t);
+        return out;
 
     }
 
-    return out;
+};
 
-}
 #undef COMBINING_LOW_LINE
 #endif
-
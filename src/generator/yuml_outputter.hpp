@@ -24,106 +24,129 @@
 
 #include <srcuml_outputter.hpp>
 
-class yuml_outputter : srcuml_outputter {
+class yuml_outputter : public srcuml_outputter {
 
 public:
 
-	yuml_outputter(){};
+	yuml_outputter(std::size_t jobs = 1) : srcuml_outputter(jobs) {};
 
-	bool output(std::ostream & out, std::vector<std::shared_ptr<srcuml_class>> & classes){
+	using srcuml_outputter::output;
 
-        srcuml_relationships relationships = analyze_relationships(classes);
+	bool output(std::ostream & stream, std::vector<srcuml_class *> & classes, srcuml_relationships & relationships){
+
+        srcuml_output_buffer out(stream);
+        out.reserve(classes.size() * CLASS_SIZE_HINT + relationships.get_relationships().size() * RELATIONSHIP_SIZE_HINT);
+
+        srcuml_thread_pool pool(jobs);
+
+        // decorated names by node id, which is the class position
+        std::vector<std::string> srcuml_names(classes.size());
 
         //Classes
 
-        for(const std::shared_ptr<srcuml_class> & aclass : classes){
+        render(pool, out, classes.size(), [&](srcuml_output_buffer & buffer, std::size_t class_num) {
 
-            out << '[';
+            srcuml_names[class_num] = classes[class_num]->get_srcuml_name();
+            output_class(buffer, srcuml_names[class_num], classes[class_num]);
 
-            out << aclass->get_srcuml_name();
+        });
 
-            if(aclass->get_has_field() || aclass->get_has_method())
-                out << '|';
+        //Relations
 
-            for(const srcuml_attribute & attribute : aclass->get_attributes()) {
-                if(attribute.get_is_static()) {
-                    static_outputter::output(out, attribute);
-                } else {
-                    out << attribute;
-                }
-                out << ';';
-            }
+        const std::vector<srcuml_relationship> & edges = relationships.get_relationships();
+        render(pool, out, edges.size(), [&](srcuml_output_buffer & buffer, std::size_t edge) {
+            output_relationship(buffer, srcuml_names, edges[edge]);
+        });
+
+        return true;
+
+	}
+
+private:
 
-            if(aclass->get_has_method())
-                out << '|';
-
-            for(std::size_t access = 0; access <= ClassPolicy::PROTECTED; ++access) {
-                for(const FunctionPolicy::FunctionData * function : aclass->get_data().methods[access]) {
-                    srcuml_operation op(function, (ClassPolicy::AccessSpecifier)access);
-                    if(op.get_stereotypes().count("set") > 0){continue;}
-                    if(op.get_stereotypes().count("get") > 0){continue;}
-                    if(function->isStatic) {
-                        static_outputter::output(out, op);
-                    } else {
-                        out << op;
-                    }
-                    out << ';';
-                }
+	static void output_class(srcuml_output_buffer & out, const std::string & srcuml_name, const srcuml_class * aclass) {
+
+        out << '[';
+
+        out << srcuml_name;
+
+        if(aclass->get_has_field() || aclass->get_has_method())
+            out << '|';
+
+        for(const srcuml_attribute & attribute : aclass->get_attributes()) {
+            if(attribute.get_is_static()) {
+                static_outputter::output(out, attribute);
+            } else {
+                out << attribute;
             }
+            out << ';';
+        }
+
+        if(aclass->get_has_method())
+            out << '|';
 
-            out << "]\n";
+        for(const srcuml_operation & op : aclass->get_operations()) {
+            if(op.has_stereotype(srcuml_operation::ACCESSOR)) continue;
+            if(op.get_is_static()) {
+                static_outputter::output(out, op);
+            } else {
+                out << op;
+            }
+            out << ';';
         }
 
-        //Relations
+        out << "]\n";
 
-        for(const srcuml_relationship relationship : relationships.get_relationships()) {
-            out << '[' << relationship.get_source() << ']';
+	}
 
-            if(relationship.type == BIDIRECTIONAL)
-                out << '<';
+	static void output_relationship(srcuml_output_buffer & out, const std::vector<std::string> & srcuml_names, const srcuml_relationship & relationship) {
 
-            out << relationship.get_source_label();
+        out << '[' << srcuml_names[relationship.get_source_node()] << ']';
 
-            switch(relationship.type) {
+        if(relationship.type == BIDIRECTIONAL)
+            out << '<';
 
-                case DEPENDENCY: {
-                    out << "-.-";
-                    break;
-                }
-                case ASSOCIATION:
-                case BIDIRECTIONAL: {
-                    out << '-';
-                break;
-                }
-                case AGGREGATION: {
-                    out << "<>-";
-                    break;
-                }
-                case COMPOSITION: {
-                    out << "++-";
-                    break;
-                }
-                case GENERALIZATION: {
-                    out << "^-";
-                    break;
-                }
-                case REALIZATION: {
-                    out << "^-.-";
-                    break;
-                }
+        out << relationship.get_source_label();
 
+        switch(relationship.type) {
+
+            case DEPENDENCY: {
+                out << "-.-";
+                break;
+            }
+            case ASSOCIATION:
+            case BIDIRECTIONAL: {
+                out << '-';
+            break;
+            }
+            case AGGREGATION: {
+                out << "<>-";
+                break;
+            }
+            case COMPOSITION: {
+                out << "++-";
+                break;
+            }
+            case GENERALIZATION: {
+                out << "^-";
+                break;
+            }
+            case REALIZATION: {
+                out << "^-.-";
+                break;
             }
 
-            out << relationship.get_destination_label();
+        }
+
+        out << relationship.get_destination_label();
 
-            if(relationship.type != GENERALIZATION && relationship.type != REALIZATION)
-                out << '>';
+        if(relationship.type != GENERALIZATION && relationship.type != REALIZATION)
+            out << '>';
 
-            out << '[' << relationship.get_destination() << "]\n";
-        }
+        out << '[' << srcuml_names[relationship.get_destination_node()] << "]\n";
 
 	}
 
 };
 
-#endif
\ No newline at end of file
+#endif
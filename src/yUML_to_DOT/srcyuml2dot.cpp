@@ -0,0 +1,152 @@
+/**
+ * @file srcyuml2dot.cpp
+ *
+ * @copyright Copyright (C) 2015-2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcUML.
+ *
+ * srcUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * srcUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ /*
+
+  Convert a yUML class diagram, e.g., one written by srcuml --format yuml,
+  to DOT.  Replaces srcYUML2graphViz.py, without the Python and ANTLR
+  runtimes.
+
+  Input: input_file.yuml, standard input if -
+  Options: --jobs N
+  Useage: srcyuml2dot [options] input_file.yuml [output_file]
+  
+  */
+
+#include <dot_outputter.hpp>
+#include <srcuml_yuml_reader.hpp>
+#include <srcuml_input.hpp>
+
+#include <tclap/CmdLine.h>
+
+#include <iostream>
+#include <fstream>
+
+/**
+ * yuml_dot_outputter
+ *
+ * Renders the boxes of a yUML diagram as the record nodes dot_outputter
+ * renders classes as, with its header and edges.  The members are
+ * already rendered, so they are copied as read.
+ */
+class yuml_dot_outputter : public dot_outputter {
+
+public:
+
+  yuml_dot_outputter(std::size_t jobs = 1) : dot_outputter(jobs) {}
+
+  bool output(std::ostream & stream, const srcuml_yuml_reader & diagram) {
+
+    const std::vector<srcuml_yuml_reader::node> & nodes = diagram.get_nodes();
+    const std::vector<srcuml_relationship> & edges = diagram.get_relationships();
+
+    srcuml_output_buffer out(stream);
+    out.reserve(nodes.size() * CLASS_SIZE_HINT + edges.size() * RELATIONSHIP_SIZE_HINT);
+
+    output_header(out);
+
+    srcuml_thread_pool pool(jobs);
+
+    render(pool, out, nodes.size(), [&](srcuml_output_buffer & buffer, std::size_t node) {
+      output_node(buffer, node, nodes[node]);
+    });
+
+    render(pool, out, edges.size(), [&](srcuml_output_buffer & buffer, std::size_t edge) {
+      output_relationship(buffer, edges[edge]);
+    });
+
+    out << '}' << '\n';
+
+    return true;
+
+  }
+
+private:
+
+  static void output_node(srcuml_output_buffer & out, std::size_t node_num, const srcuml_yuml_reader::node & node) {
+
+    out << "class" << node_num << "[label = \"{ ";
+    out << node.name;
+    if(node.has_field)
+      out << '|';
+
+    for(const std::string & attribute : node.attributes)
+      out << attribute << "\\n";
+
+    if(node.has_method)
+      out << '|';
+
+    for(const std::string & op : node.operations)
+      out << op << "\\n";
+
+    out << "}\"]\n";
+
+  }
+
+};
+
+/**
+ * main
+ * @param argc number of arguments
+ * @param argv the provided arguments (array of C strings)
+ * 
+ * Read the yUML and output it as DOT.
+ */
+int main(int argc, char * argv[]) {
+
+  TCLAP::CmdLine cmd("Convert a yUML class diagram to DOT", ' ', "0.1");
+
+  TCLAP::UnlabeledValueArg<std::string> input_arg("input", "yUML diagram, - for standard input", true, "", "input_file", cmd);
+  TCLAP::UnlabeledValueArg<std::string> output_arg("output", "file to write, standard output by default", false, "", "output_file", cmd);
+  TCLAP::ValueArg<std::size_t> jobs_arg("j", "jobs", "number of threads rendering the diagram, 0 uses all cores", false, 1, "N", cmd);
+
+  cmd.parse(argc, argv);
+
+  std::string input_filename = input_arg.getValue();
+  if(input_filename == "-")
+    input_filename = "/dev/stdin";
+
+  std::ostream * out = &std::cout;
+  
+  if(!output_arg.getValue().empty())
+    out = new std::ofstream(output_arg.getValue());
+
+  int status = 0;
+  try {
+
+    srcuml_input input(input_filename.c_str());
+    srcuml_yuml_reader diagram(input.get_data(), input.get_size());
+
+    yuml_dot_outputter outputter(jobs_arg.getValue());
+    outputter.output(*out, diagram);
+
+  } catch(const std::exception & error) {
+
+    std::cerr << "srcyuml2dot: " << error.what() << '\n';
+    status = 1;
+
+  }
+
+  if(out != &std::cout)
+    delete out;
+
+  return status;
+}
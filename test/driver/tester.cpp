@@ -25,12 +25,13 @@
 #include <srcuml_handler.hpp>
 
 #include <sstream>
+#include <exception>
 #include <iostream>
 #include <iomanip>
 
 const size_t tester_t::COLUMN_SIZE = 80;
 
-tester_t::tester_t(const std::string & name) : name(name), test_count(0), number_passed(0), source_code(), srcml(), yuml() {}
+tester_t::tester_t(const std::string & name) : name(name), test_count(0), number_passed(0), source_code(), srcml(), yuml(), error() {}
 
 
 tester_t & tester_t::src2srcml(const std::string & src) {
@@ -60,15 +61,125 @@ tester_t & tester_t::src2srcml(const std::string & src) {
 
 }
 
+/** the xmlns attributes of the first unit start tag */
+static std::string get_namespaces(const std::string & document) {
+
+    std::string namespaces;
+
+    std::size_t tag_end = document.find('>', document.find("<unit"));
+    std::size_t pos = document.find(" xmlns");
+    while(pos < tag_end) {
+
+        std::size_t attribute_end = document.find('"', document.find('"', pos) + 1) + 1;
+        namespaces += document.substr(pos, attribute_end - pos);
+        pos = document.find(" xmlns", attribute_end);
+
+    }
+
+    return namespaces;
+
+}
+
+tester_t & tester_t::src2srcml(const std::vector<std::pair<std::string, std::string>> & units) {
+
+    source_code = std::string();
+
+    // each unit on its own, then joined under a root unit that carries the namespaces
+    std::string root_namespaces;
+    std::vector<std::string> unit_srcml;
+    for(const std::pair<std::string, std::string> & unit : units) {
+
+        source_code += unit.second;
+
+        srcml_archive * archive = srcml_archive_create();
+
+        char * srcml_buffer = nullptr;
+        size_t size = 0;
+        srcml_archive_write_open_memory(archive, &srcml_buffer, &size);
+
+        srcml_unit * parsed_unit = srcml_unit_create(archive);
+        srcml_unit_set_language(parsed_unit, "C++");
+        srcml_unit_set_filename(parsed_unit, unit.first.c_str());
+        srcml_unit_parse_memory(parsed_unit, unit.second.c_str(), unit.second.size());
+
+        srcml_archive_write_unit(archive, parsed_unit);
+        srcml_unit_free(parsed_unit);
+
+        srcml_archive_close(archive);
+        srcml_archive_free(archive);
+
+        std::string document(srcml_buffer, size);
+        srcml_memory_free(srcml_buffer);
+
+        // the namespaces are on the first unit, the code is in the last one
+        if(root_namespaces.empty())
+            root_namespaces = get_namespaces(document);
+
+        std::size_t begin = document.rfind("<unit");
+        std::size_t end = document.find("</unit>", begin) + std::string("</unit>").size();
+        unit_srcml.push_back(document.substr(begin, end - begin));
+
+    }
+
+    srcml = "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n";
+    if(unit_srcml.size() == 1) {
+
+        std::string & unit = unit_srcml.front();
+        if(unit.find(" xmlns=") > unit.find('>'))
+            unit.insert(std::string("<unit").size(), root_namespaces);
+        srcml += unit + "\n";
+
+    } else {
+
+        srcml += "<unit" + root_namespaces + ">\n\n";
+        for(const std::string & unit : unit_srcml)
+            srcml += unit + "\n\n";
+        srcml += "</unit>\n";
+
+    }
+
+    return *this;
+
+}
+
+tester_t & tester_t::set_srcml(const std::string & srcml) {
+
+    this->srcml = srcml;
+
+    return *this;
+
+}
+
+const std::string & tester_t::get_srcml() const {
+
+    return srcml;
+
+}
+
 tester_t & tester_t::run() {
 
+    return run(srcuml_options());
+
+}
+
+tester_t & tester_t::run(const srcuml_options & options) {
+
     std::ostringstream output;
+    error = std::string();
 
     try {
 
-        srcuml_handler handler(srcml, output);
+        srcuml_handler handler(srcml, output, options);
+
+    } catch(const std::exception & exception) {
+
+        error = exception.what();
 
-    } catch(...) {}
+    } catch(...) {
+
+        error = "unknown error";
+
+    }
 
     yuml = output.str();
 
@@ -76,29 +187,115 @@ tester_t & tester_t::run() {
 
 }
 
+tester_t & tester_t::run_file(const std::string & filename, const srcuml_options & options) {
+
+    std::ostringstream output;
+    error = std::string();
+
+    try {
+
+        srcuml_handler handler(filename.c_str(), output, options);
+
+    } catch(const std::exception & exception) {
+
+        error = exception.what();
+
+    } catch(...) {
+
+        error = "unknown error";
+
+    }
+
+    yuml = output.str();
+
+    return *this;
+
+}
+
+tester_t & tester_t::run_source(const std::vector<std::string> & paths, const srcuml_options & options) {
+
+    std::ostringstream output;
+    error = std::string();
+
+    try {
+
+        srcuml_handler handler(srcuml_source(paths), output, options);
+
+    } catch(const std::exception & exception) {
+
+        error = exception.what();
+
+    } catch(...) {
+
+        error = "unknown error";
+
+    }
+
+    yuml = output.str();
+
+    return *this;
+
+}
+
+const std::string & tester_t::get_output() const {
+
+    return yuml;
+
+}
+
+tester_t & tester_t::output(const std::string & text) {
+
+    yuml = text;
+
+    return *this;
+
+}
+
 tester_t & tester_t::test(const std::string & expected_yuml) {
 
+    add_result(yuml == expected_yuml, "expected", expected_yuml, yuml);
+
+    yuml = std::string();
+
+    return *this;
+}
+
+tester_t & tester_t::test_contains(const std::string & expected_text) {
+
+    add_result(yuml.find(expected_text) != std::string::npos, "expected to contain", expected_text + "\n", yuml);
+
+    return *this;
+
+}
+
+tester_t & tester_t::test_error(const std::string & expected_error) {
+
+    add_result(error == expected_error, "expected error", expected_error + "\n", error + "\n");
+
+    return *this;
+
+}
+
+void tester_t::add_result(bool passed, const std::string & label, const std::string & expected, const std::string & actual) {
+
     ++test_count;
 
-    if(yuml == expected_yuml) {
+    if(passed) {
 
         ++number_passed;
         test_results.push_back(std::make_tuple(test_count, true, ""));
 
     } else {
 
-        std::string error = "### expected ###\n";
-        error += expected_yuml;
+        std::string error = "### " + label + " ###\n";
+        error += expected;
         error += "### actual ###\n";
-        error += yuml;
+        error += actual;
         error += "### end ###\n\n";
         test_results.push_back(std::make_tuple(test_count, false, error));
 
     }
 
-    yuml = std::string();
-
-    return *this;
 }
 
 static size_t number_characters(size_t number) {
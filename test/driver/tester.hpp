@@ -22,9 +22,12 @@
 #ifndef INCLUDED_TESTER_HPP
 #define INCLUDED_TESTER_HPP
 
+#include <srcuml_options.hpp>
+
 #include <string>
 #include <vector>
 #include <tuple>
+#include <utility>
 
 class tester_t {
 
@@ -43,17 +46,41 @@ private:
     std::string source_code;
     std::string srcml;
     std::string yuml;
+    std::string error;
 
 public:
 
     tester_t(const std::string & name);
 
     tester_t & src2srcml(const std::string & src);
+    /** one unit per (filename, source), an archive if there are several */
+    tester_t & src2srcml(const std::vector<std::pair<std::string, std::string>> & units);
+    /** srcML to run on, e.g., the srcML of src2srcml with attributes srcML adds for other tools */
+    tester_t & set_srcml(const std::string & srcml);
+    const std::string & get_srcml() const;
     tester_t & run();
+    tester_t & run(const srcuml_options & options);
+    /** run on a file, e.g., a saved model, instead of the srcML */
+    tester_t & run_file(const std::string & filename, const srcuml_options & options = srcuml_options());
+    /** run on source files and directories, converted to srcML in memory */
+    tester_t & run_source(const std::vector<std::string> & paths, const srcuml_options & options = srcuml_options());
+    /** test text rendered without a run, e.g., by an outputter directly */
+    tester_t & output(const std::string & text);
     tester_t & test(const std::string & expected_yuml);
+    /** test that the output contains the text, the output is kept for further tests */
+    tester_t & test_contains(const std::string & expected_text);
+    /** test the message of the exception the last run threw, empty if none */
+    tester_t & test_error(const std::string & expected_error);
+
+    /** output of the last run, to compare runs with different options */
+    const std::string & get_output() const;
 
     size_t results() const;
 
+private:
+
+    void add_result(bool passed, const std::string & label, const std::string & expected, const std::string & actual);
+
 };
 
 
@@ -0,0 +1,73 @@
+/**
+ * @file test_cache.cpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcYUML.
+ *
+ * srcYUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * srcYUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcYUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tester.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <utility>
+
+/** the DOT diagram for the given nodes */
+static std::string dot(const std::string & body) {
+
+    return "digraph hierarchy {\nnode[shape=record,style=filled,fillcolor=gray95]\nedge[dir=\"both\", arrowtail=\"empty\", arrowhead=\"empty\", labeldistance=\"2.0\"]\n"
+        + body + "}\n";
+
+}
+
+int main(int argc, char * argv[]) {
+
+    tester_t tester("cache");
+
+    srcuml_options options;
+    options.cache_file = "test_cache.srcuml";
+    std::remove(options.cache_file.c_str());
+
+    const std::string first = "class0[label = \"{ «datatype»\\nfirst|- id: number\\n}\"]\n";
+    const std::string second = "class1[label = \"{ «datatype»\\nsecond|- id: number\\n}\"]\n";
+    const std::string changed = "class1[label = \"{ «datatype»\\nsecond|- id: number\\n- size: number\\n}\"]\n";
+
+    // a single unit, the second run reads it from the cache
+    std::vector<std::pair<std::string, std::string>> unit = { { "first.cpp", "class first { int id; };\n" } };
+    tester.src2srcml(unit).run(options).test(dot(first));
+    tester.src2srcml(unit).run(options).test(dot(first));
+
+    // an archive, only the changed unit is parsed again
+    std::vector<std::pair<std::string, std::string>> units = {
+        { "first.cpp", "class first { int id; };\n" },
+        { "second.cpp", "class second { int id; };\n" }
+    };
+    tester.src2srcml(units).run(options).test(dot(first + second));
+    tester.src2srcml(units).run(options).test(dot(first + second));
+
+    units[1].second = "class second { int id; double size; };\n";
+    tester.src2srcml(units).run(options).test(dot(first + changed));
+
+    // and a changed single unit
+    unit[0].second = "class first { int id; int count; };\n";
+    tester.src2srcml(unit).run(options).test(dot("class0[label = \"{ «datatype»\\nfirst|- id: number\\n- count: number\\n}\"]\n"));
+
+    std::remove(options.cache_file.c_str());
+
+    return tester.results();
+
+}
@@ -37,6 +37,25 @@ int main(int argc, char * argv[]) {
 
 	}
 
+    // one edge for every use of a class, weighted by the number of uses
+    tester.src2srcml("class bar { int id; };\nclass foo { bar f(bar a) { bar b; return b; } };\n").run()
+          .test("digraph hierarchy {\nnode[shape=record,style=filled,fillcolor=gray95]\nedge[dir=\"both\", arrowtail=\"empty\", arrowhead=\"empty\", labeldistance=\"2.0\"]\n"
+                "class0[label = \"{ «datatype»\\nbar|- id: number\\n}\"]\nclass1[label = \"{ «datatype»\\nfoo||- f(a: bar): bar\\n}\"]\n"
+                "class1->class0[arrowhead=\"vee\", arrowtail=\"none\", style=\"dashed\", weight=\"3\", label=\"3\", tooltip=\"1 parameter, 1 local, 1 return\"]\n}\n");
+
+    // without dependencies no body is parsed, nor the body of a lambda in a default argument
+    const std::string lambda_default = "class bar { int id; };\nclass pan { int id; };\n"
+                                       "class foo { public: void f(int n = []() { bar b; return 1; }()) { pan p; } };\n";
+    tester.src2srcml(lambda_default).run()
+          .test_contains("class2->class1[arrowhead=\"vee\", arrowtail=\"none\", style=\"dashed\"]\n");
+
+    srcuml_options no_dependencies;
+    no_dependencies.dependencies = false;
+    tester.src2srcml(lambda_default).run(no_dependencies)
+          .test("digraph hierarchy {\nnode[shape=record,style=filled,fillcolor=gray95]\nedge[dir=\"both\", arrowtail=\"empty\", arrowhead=\"empty\", labeldistance=\"2.0\"]\n"
+                "class0[label = \"{ «datatype»\\nbar|- id: number\\n}\"]\nclass1[label = \"{ «datatype»\\npan|- id: number\\n}\"]\n"
+                "class2[label = \"{ «datatype»\\nfoo||+ f(n: number)\\n}\"]\n}\n");
+
     return tester.results();
 
 }
\ No newline at end of file
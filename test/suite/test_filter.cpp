@@ -0,0 +1,69 @@
+/**
+ * @file test_filter.cpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcYUML.
+ *
+ * srcYUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * srcYUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcYUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tester.hpp>
+
+#include <string>
+#include <vector>
+#include <utility>
+
+/** the DOT diagram for the given nodes */
+static std::string dot(const std::string & body) {
+
+    return "digraph hierarchy {\nnode[shape=record,style=filled,fillcolor=gray95]\nedge[dir=\"both\", arrowtail=\"empty\", arrowhead=\"empty\", labeldistance=\"2.0\"]\n"
+        + body + "}\n";
+
+}
+
+int main(int argc, char * argv[]) {
+
+    tester_t tester("filter");
+
+    const std::string source = "namespace a { class keep { int id; }; }\nclass drop { int id; };\n";
+    const std::string keep = "class0[label = \"{ «datatype»\\nkeep|- id: number\\n}\"]\n";
+    const std::string drop = "class0[label = \"{ «datatype»\\ndrop|- id: number\\n}\"]\n";
+
+    // class patterns match qualified names
+    srcuml_options include;
+    include.includes.push_back("a::*");
+    tester.src2srcml(source).run(include).test(dot(keep));
+
+    srcuml_options exclude;
+    exclude.excludes.push_back("drop");
+    tester.src2srcml(source).run(exclude).test(dot(keep));
+
+    // unit patterns match filenames, in an archive
+    srcuml_options exclude_unit;
+    exclude_unit.unit_excludes.push_back("*_test.cpp");
+
+    std::vector<std::pair<std::string, std::string>> units = {
+        { "keep.cpp", "class keep { int id; };\n" },
+        { "drop_test.cpp", "class drop { int id; };\n" }
+    };
+    tester.src2srcml(units).run(exclude_unit).test(dot(keep));
+
+    // and of a single unit
+    tester.src2srcml({ { "drop_test.cpp", "class drop { int id; };\n" } }).run(exclude_unit).test(dot(""));
+    tester.src2srcml({ { "drop.cpp", "class drop { int id; };\n" } }).run(exclude_unit).test(dot(drop));
+
+    return tester.results();
+
+}
@@ -0,0 +1,78 @@
+/**
+ * @file test_graph.cpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcYUML.
+ *
+ * srcYUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * srcYUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcYUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tester.hpp>
+
+#include <srcuml_model.hpp>
+#include <srcuml_input.hpp>
+#include <srcuml_relationship.hpp>
+
+#include <cstdio>
+#include <string>
+
+/** each class with the classes at the end of its outgoing and incoming edges */
+static std::string adjacency(srcuml_relationships & relationships, std::size_t class_count) {
+
+    std::string text;
+    for(std::uint32_t node = 0; node < class_count; ++node) {
+
+        text += relationships.get_class(node)->get_name() + ":";
+
+        for(std::uint32_t edge : relationships.get_graph().get_out_edges(node))
+            text += " ->" + relationships.get_class(relationships.get_relationship(edge).destination_node)->get_name();
+
+        for(std::uint32_t edge : relationships.get_graph().get_in_edges(node))
+            text += " <-" + relationships.get_class(relationships.get_relationship(edge).source_node)->get_name();
+
+        text += '\n';
+
+    }
+
+    return text;
+
+}
+
+int main(int argc, char * argv[]) {
+
+    tester_t tester("graph");
+
+    srcuml_options options;
+    options.model_file = "test_graph.srcuml";
+
+    // the edges of each node in edge order: realization, aggregation, then dependency
+    tester.src2srcml("class shape { public: virtual double area() const = 0; };\n"
+                     "class square : public shape { public: double area() const; private: int side; };\n"
+                     "class canvas { square * selected; public: void draw(shape * s) {} };\n").run(options);
+
+    {
+        srcuml_input input(options.model_file.c_str());
+        srcuml_model model(input.get_data(), input.get_size(), options.model_file);
+        srcuml_relationships relationships(model.get_classes(), model.get_relationships());
+
+        tester.output(adjacency(relationships, model.get_classes().size()))
+              .test("shape: ->square <-canvas\nsquare: <-shape <-canvas\ncanvas: ->square ->shape\n");
+    }
+
+    std::remove(options.model_file.c_str());
+
+    return tester.results();
+
+}
@@ -0,0 +1,88 @@
+/**
+ * @file test_inheritance.cpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcYUML.
+ *
+ * srcYUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * srcYUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcYUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tester.hpp>
+
+#include <string>
+
+/** the DOT diagram for the given nodes and edges, which show the node ids */
+static std::string dot(const std::string & body) {
+
+    return "digraph hierarchy {\nnode[shape=record,style=filled,fillcolor=gray95]\nedge[dir=\"both\", arrowtail=\"empty\", arrowhead=\"empty\", labeldistance=\"2.0\"]\n"
+        + body + "}\n";
+
+}
+
+int main(int argc, char * argv[]) {
+
+    tester_t tester("inheritance");
+
+    const std::string generalization = "[arrowhead=\"none\"]\n";
+    const std::string realization = "[arrowhead=\"none\", style=\"dashed\"]\n";
+
+    // a hierarchy deeper than the stack allows recursion, the pure virtual is implemented at the bottom
+    const std::size_t DEPTH = 200000;
+
+    std::string source = "class c0 { public: virtual void run() = 0; };\n";
+    std::string nodes = "class0[label = \"{ «interface»\\nc0||+ run()\\n}\"]\n";
+    std::string edges;
+    for(std::size_t depth = 1; depth < DEPTH; ++depth) {
+
+        const std::string name = "c" + std::to_string(depth);
+        const std::string parent = "c" + std::to_string(depth - 1);
+        const std::string edge = "class" + std::to_string(depth - 1) + "->class" + std::to_string(depth);
+
+        if(depth + 1 < DEPTH) {
+
+            source += "class " + name + " : public " + parent + " {};\n";
+            nodes += "class" + std::to_string(depth) + "[label = \"{ «interface»\\n" + name + "}\"]\n";
+            edges += edge + generalization;
+
+        } else {
+
+            source += "class " + name + " : public " + parent + " { public: void run(); };\n";
+            nodes += "class" + std::to_string(depth) + "[label = \"{ «datatype»\\n" + name + "||+ run()\\n}\"]\n";
+            edges += edge + realization;
+
+        }
+
+    }
+    tester.src2srcml(source).run().test(dot(nodes + edges));
+
+    // an inheritance cycle ends, and each class still has its parent
+    tester.src2srcml("class X : public Y { int id; };\nclass Y : public X { int id; };\n").run()
+          .test(dot("class0[label = \"{ «datatype»\\nX|- id: number\\n}\"]\nclass1[label = \"{ «datatype»\\nY|- id: number\\n}\"]\n"
+                    "class1->class0" + generalization + "class0->class1" + generalization));
+
+    // children sharing the inherited pure virtual functions, only overriding all of them is concrete
+    tester.src2srcml("class base { public: virtual void run() = 0; virtual void stop() = 0; };\n"
+                     "class middle : public base { int id; };\n"
+                     "class none : public middle { public: void other(); };\n"
+                     "class partial : public middle { public: void run(); };\n"
+                     "class full : public middle { public: void run(); void stop(); };\n").run()
+          .test(dot("class0[label = \"{ «interface»\\nbase||+ run()\\n+ stop()\\n}\"]\nclass1[label = \"{  ｛abstract｝\\nmiddle|- id: number\\n}\"]\n"
+                    "class2[label = \"{  ｛abstract｝\\nnone||+ other()\\n}\"]\nclass3[label = \"{  ｛abstract｝\\npartial||+ run()\\n}\"]\n"
+                    "class4[label = \"{ «datatype»\\nfull||+ run()\\n+ stop()\\n}\"]\n"
+                    "class0->class1" + generalization + "class1->class2" + generalization + "class1->class3" + generalization + "class1->class4" + realization));
+
+    return tester.results();
+
+}
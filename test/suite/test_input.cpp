@@ -0,0 +1,93 @@
+/**
+ * @file test_input.cpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcYUML.
+ *
+ * srcYUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * srcYUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcYUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tester.hpp>
+#include <srcuml_input.hpp>
+
+#include <string>
+#include <fstream>
+#include <thread>
+#include <cstdio>
+
+#include <sys/stat.h>
+
+static std::string get_read_mode(const srcuml_input & input) {
+    return input.get_is_mapped() ? "mapped\n" : "read\n";
+}
+
+static std::string get_contents(const srcuml_input & input) {
+    return std::string(input.get_data(), input.get_size());
+}
+
+/** a named pipe that a thread writes the text to once it is opened for reading */
+static std::thread write_pipe(const std::string & filename, const std::string & text) {
+
+    std::remove(filename.c_str());
+    mkfifo(filename.c_str(), 0600);
+
+    return std::thread([filename, text]() { std::ofstream(filename) << text; });
+
+}
+
+int main(int argc, char * argv[]) {
+
+    tester_t tester("input");
+
+    const std::string srcml = tester.src2srcml("class part { int id; };\nclass whole { part * body; };\n").get_srcml();
+
+    // a regular file is mapped
+    std::ofstream("test_input.xml") << srcml;
+    {
+        srcuml_input input("test_input.xml");
+        tester.output(get_read_mode(input)).test("mapped\n");
+        tester.output(get_contents(input)).test(srcml);
+    }
+
+    // an empty file cannot be mapped, it is read instead
+    std::ofstream("test_input_empty.xml");
+    {
+        srcuml_input input("test_input_empty.xml");
+        tester.output(get_read_mode(input)).test("read\n");
+        tester.output(get_contents(input)).test("");
+    }
+
+    // a pipe is read through the descriptor it was opened with
+    std::thread writer = write_pipe("test_input.fifo", srcml);
+    {
+        srcuml_input input("test_input.fifo");
+        tester.output(get_read_mode(input)).test("read\n");
+        tester.output(get_contents(input)).test(srcml);
+    }
+    writer.join();
+
+    // the diagram read from a pipe is the diagram of the file
+    tester.run_file("test_input.xml").test_contains("class1->class0[arrowhead=\"none\", arrowtail=\"odiamond\"]\n").test_error("");
+    const std::string diagram = tester.get_output();
+
+    writer = write_pipe("test_input.fifo", srcml);
+    tester.run_file("test_input.fifo").test(diagram);
+    writer.join();
+
+    tester.run_file("test_input_missing.xml").test_error("Unable to open input file: test_input_missing.xml");
+
+    return tester.results();
+
+}
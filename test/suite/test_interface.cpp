@@ -24,6 +24,14 @@
 #include <string>
 #include <vector>
 
+/** the DOT diagram for the given nodes and edges, which show the node ids */
+static std::string dot(const std::string & body) {
+
+    return "digraph hierarchy {\nnode[shape=record,style=filled,fillcolor=gray95]\nedge[dir=\"both\", arrowtail=\"empty\", arrowhead=\"empty\", labeldistance=\"2.0\"]\n"
+        + body + "}\n";
+
+}
+
 int main(int argc, char * argv[]) {
 
     tester_t tester("interface");
@@ -124,6 +132,30 @@ int main(int argc, char * argv[]) {
 
     }
 
+    const std::string generalization = "[arrowhead=\"none\"]\n";
+    const std::string realization = "[arrowhead=\"none\", style=\"dashed\"]\n";
+
+    // overrides match on parameter types, not names
+    tester.src2srcml("class shape { public: virtual void draw(int width, int height) = 0; };\n"
+                     "class square : public shape { public: void draw(int w, int h); };\n").run()
+          .test(dot("class0[label = \"{ «interface»\\nshape||+ draw(width: number, height: number)\\n}\"]\n"
+                    "class1[label = \"{ «datatype»\\nsquare||+ draw(w: number, h: number)\\n}\"]\n"
+                    "class0->class1" + realization));
+
+    // an overload differing only in const does not override
+    tester.src2srcml("class base { public: virtual int value() const = 0; };\n"
+                     "class child : public base { public: int value(); };\n").run()
+          .test(dot("class0[label = \"{ «interface»\\nbase||+ value(): number\\n}\"]\nclass1[label = \"{  ｛abstract｝\\nchild||+ value(): number\\n}\"]\n"
+                    "class0->class1" + generalization));
+
+    // volatile and reference qualifiers are part of the signature
+    tester.src2srcml("class base { public: virtual int value() & = 0; virtual void reset() volatile = 0; };\n"
+                     "class moved : public base { public: int value() &&; void reset() volatile; };\n"
+                     "class copied : public base { public: int value() &; void reset() volatile; };\n").run()
+          .test(dot("class0[label = \"{ «interface»\\nbase||+ value(): number\\n+ reset()\\n}\"]\nclass1[label = \"{  ｛abstract｝\\nmoved||+ value(): number\\n+ reset()\\n}\"]\n"
+                    "class2[label = \"{ «datatype»\\ncopied||+ value(): number\\n+ reset()\\n}\"]\n"
+                    "class0->class1" + generalization + "class0->class2" + realization));
+
     return tester.results();
 
 }
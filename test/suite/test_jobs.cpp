@@ -0,0 +1,74 @@
+/**
+ * @file test_jobs.cpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcYUML.
+ *
+ * srcYUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * srcYUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcYUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tester.hpp>
+
+#include <string>
+#include <vector>
+#include <utility>
+
+static srcuml_options jobs_options(std::size_t jobs) {
+
+    srcuml_options options;
+    options.jobs = jobs;
+
+    return options;
+
+}
+
+/** the srcML with text inserted before the unit of the first file */
+static std::string insert_before_units(std::string srcml, const std::string & text) {
+
+    srcml.insert(srcml.find("<unit", srcml.find("<unit") + 1), text);
+    return srcml;
+
+}
+
+int main(int argc, char * argv[]) {
+
+    tester_t tester("jobs");
+
+    const std::vector<std::pair<std::string, std::string>> units = {
+        { "part.hpp",  "class part { int id; };\n" },
+        { "whole.hpp", "class whole { part * body; };\n" },
+        { "user.hpp",  "class user { public: void use(whole & item); };\n" }
+    };
+
+    // the whole archive parsed at once
+    tester.src2srcml(units).run(jobs_options(1))
+          .test_contains("class1->class0[arrowhead=\"none\", arrowtail=\"odiamond\"]\n")
+          .test_contains("class2->class1[arrowhead=\"vee\", arrowtail=\"none\", style=\"dashed\"]\n")
+          .test_error("");
+
+    const std::string serial = tester.get_output();
+
+    // each unit parsed on its own, in order
+    tester.src2srcml(units).run(jobs_options(2)).test(serial);
+    tester.src2srcml(units).run(jobs_options(0)).test(serial);
+
+    // a comment or another element among the units is not an archive, it is parsed at once
+    const std::string srcml = tester.src2srcml(units).get_srcml();
+    tester.set_srcml(insert_before_units(srcml, "<!-- generated -->\n\n")).run(jobs_options(2)).test(serial);
+    tester.set_srcml(insert_before_units(srcml, "<info/>\n\n")).run(jobs_options(2)).test(serial);
+
+    return tester.results();
+
+}
@@ -0,0 +1,56 @@
+/**
+ * @file test_json.cpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcYUML.
+ *
+ * srcYUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * srcYUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcYUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tester.hpp>
+
+#include <string>
+
+int main(int argc, char * argv[]) {
+
+    tester_t tester("json");
+
+    srcuml_options options;
+    options.outputs.push_back(srcuml_options::output_target{ "json", "" });
+
+    // types as declared with the numeric category on its own
+    tester.src2srcml("class node { int id; node * next; public: double weight(int scale) const; };\n").run(options)
+          .test("{\"record\":\"model\",\"classes\":1,\"relationships\":1}\n"
+                "{\"record\":\"class\",\"id\":0,\"name\":\"node\",\"namespace\":\"\",\"interface\":false,\"abstract\":false,\"datatype\":true,\"parents\":[],"
+                "\"attributes\":[{\"name\":\"id\",\"type\":\"int\",\"numeric\":true,\"multiplicity\":\"\",\"visibility\":\"private\",\"static\":false},"
+                "{\"name\":\"next\",\"type\":\"node\",\"numeric\":false,\"multiplicity\":\"［*］\",\"visibility\":\"private\",\"static\":false}],"
+                "\"operations\":[{\"name\":\"weight\",\"return_type\":\"double\",\"return_numeric\":true,"
+                "\"parameters\":[{\"name\":\"scale\",\"type\":\"int\",\"numeric\":true,\"multiplicity\":\"\"}],"
+                "\"visibility\":\"public\",\"static\":false,\"const\":true,\"pure_virtual\":false,\"stereotype\":\"\",\"stereotypes\":[]}]}\n"
+                "{\"record\":\"relationship\",\"type\":\"aggregation\",\"source\":0,\"destination\":0,\"source_label\":\"\",\"destination_label\":\"next［*］\"}\n");
+
+    // text is escaped, the stereotype is as a stereotyping tool wrote it in the srcML
+    std::string srcml = tester.src2srcml("class tagged { public: void run() {} };\n").get_srcml();
+    srcml.replace(srcml.find("<function>"), std::string("<function>").size(), "<function stereotype=\"command &quot;quoted&quot; \\ name&#9;&#10;&#13;\">");
+    tester.set_srcml(srcml).run(options)
+          .test("{\"record\":\"model\",\"classes\":1,\"relationships\":0}\n"
+                "{\"record\":\"class\",\"id\":0,\"name\":\"tagged\",\"namespace\":\"\",\"interface\":false,\"abstract\":false,\"datatype\":true,\"parents\":[],"
+                "\"attributes\":[],\"operations\":[{\"name\":\"run\",\"return_type\":\"void\",\"return_numeric\":false,\"parameters\":[],"
+                "\"visibility\":\"public\",\"static\":false,\"const\":false,\"pure_virtual\":false,"
+                "\"stereotype\":\"command \\\"quoted\\\" \\\\ name\\t\\n\\r\",\"stereotypes\":[\"command\"]}]}\n");
+
+    return tester.results();
+
+}
@@ -0,0 +1,46 @@
+/**
+ * @file test_model.cpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcYUML.
+ *
+ * srcYUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * srcYUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcYUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tester.hpp>
+
+#include <cstdio>
+#include <string>
+
+int main(int argc, char * argv[]) {
+
+    tester_t tester("model");
+
+    srcuml_options options;
+    options.model_file = "test_model.srcuml";
+
+    // a saved model outputs the same diagram without parsing
+    const std::string source = "namespace shapes { class shape { public: virtual double area() const = 0; }; }\n"
+                               "class square : public shapes::shape { public: square(); double area() const; private: int side; };\n"
+                               "class canvas { std::vector<shapes::shape *> shapes; square * selected; public: void draw(square s) { shapes::shape * last; } };\n";
+
+    const std::string diagram = tester.src2srcml(source).run(options).get_output();
+    tester.run_file(options.model_file).test(diagram);
+
+    std::remove(options.model_file.c_str());
+
+    return tester.results();
+
+}
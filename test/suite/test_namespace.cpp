@@ -0,0 +1,97 @@
+/**
+ * @file test_namespace.cpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcYUML.
+ *
+ * srcYUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * srcYUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcYUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tester.hpp>
+
+#include <string>
+#include <vector>
+#include <utility>
+
+static srcuml_options jobs_options(std::size_t jobs) {
+
+    srcuml_options options;
+    options.jobs = jobs;
+
+    return options;
+
+}
+
+/** the DOT diagram for the given nodes and edges, which show the node ids */
+static std::string dot(const std::string & body) {
+
+    return "digraph hierarchy {\nnode[shape=record,style=filled,fillcolor=gray95]\nedge[dir=\"both\", arrowtail=\"empty\", arrowhead=\"empty\", labeldistance=\"2.0\"]\n"
+        + body + "}\n";
+
+}
+
+int main(int argc, char * argv[]) {
+
+    tester_t tester("namespace");
+
+    const std::string node = "[label = \"{ «datatype»\\nNode|- id: number\\n}\"]\n";
+    const std::string aggregation = "[arrowhead=\"none\", arrowtail=\"odiamond\"]\n";
+
+    // same named classes in sibling namespaces, qualified or found in the enclosing namespace
+    tester.src2srcml("namespace a { class Node { int id; }; }\nnamespace b { class Node { int id; }; class user { a::Node * first; Node * second; }; }\n").run()
+          .test(dot("class0" + node + "class1" + node + "class2[label = \"{ «datatype»\\nuser|- first: Node［*］ ｛ordered｝\\n- second: Node［*］ ｛ordered｝\\n}\"]\n"
+                    "class2->class0" + aggregation + "class2->class1" + aggregation));
+
+    // using directive
+    tester.src2srcml("namespace a { class Node { int id; }; }\nnamespace c { using namespace a; class user { Node * node; }; }\n").run()
+          .test(dot("class0" + node + "class1[label = \"{ «datatype»\\nuser|- node: Node［*］ ｛ordered｝\\n}\"]\nclass1->class0" + aggregation));
+
+    // unqualified fallback, only for a unique name
+    tester.src2srcml("namespace a { class Node { int id; }; }\nclass user { Node * node; };\n").run()
+          .test(dot("class0" + node + "class1[label = \"{ «datatype»\\nuser|- node: Node［*］ ｛ordered｝\\n}\"]\nclass1->class0" + aggregation));
+    tester.src2srcml("namespace a { class Node { int id; }; }\nnamespace b { class Node { int id; }; }\nclass user { Node * node; };\n").run()
+          .test(dot("class0" + node + "class1" + node + "class2[label = \"{ «datatype»\\nuser|- node: Node［*］ ｛ordered｝\\n}\"]\n"));
+
+    // nested namespace qualifiers, absolute and relative to the enclosing namespace
+    tester.src2srcml("namespace outer { namespace inner { class Node { int id; }; } }\nclass user { outer::inner::Node * node; };\nnamespace outer { class nested { inner::Node * node; }; }\n").run()
+          .test(dot("class0" + node + "class1[label = \"{ «datatype»\\nuser|- node: Node［*］ ｛ordered｝\\n}\"]\nclass2[label = \"{ «datatype»\\nnested|- node: Node［*］ ｛ordered｝\\n}\"]\n"
+                    "class1->class0" + aggregation + "class2->class0" + aggregation));
+
+    // using directives are file scoped, a whole archive parses the same as its units one at a time
+    std::vector<std::pair<std::string, std::string>> units = {
+        { "a.cpp", "namespace a { class Node { int id; }; }\nusing namespace a;\nclass first { Node * node; };\n" },
+        { "b.cpp", "namespace b { class Node { int id; }; }\nclass second { Node * node; };\n" }
+    };
+    const std::string expected = dot("class0" + node + "class1[label = \"{ «datatype»\\nfirst|- node: Node［*］ ｛ordered｝\\n}\"]\n"
+                                     "class2" + node + "class3[label = \"{ «datatype»\\nsecond|- node: Node［*］ ｛ordered｝\\n}\"]\n"
+                                     "class1->class0" + aggregation);
+
+    tester.src2srcml(units).run(jobs_options(4)).test(expected);
+    tester.src2srcml(units).run(jobs_options(1)).test(expected);
+
+    // same named nested classes, each found from inside its own enclosing class
+    tester.src2srcml("class A { class Node { int id; }; Node * first; };\nclass B { class Node { int id; }; Node * first; };\n").run()
+          .test(dot("class0" + node + "class1[label = \"{ «datatype»\\nA|- first: Node［*］ ｛ordered｝\\n}\"]\nclass2" + node + "class3[label = \"{ «datatype»\\nB|- first: Node［*］ ｛ordered｝\\n}\"]\n"
+                    "class1->class0" + aggregation + "class3->class2" + aggregation));
+
+    // a class qualifier names only the classes nested in it
+    const std::string x = "[label = \"{ «datatype»\\nX|- id: number\\n}\"]\n";
+    tester.src2srcml("class Outer { public: class X { int id; }; };\nclass X { int id; };\nclass user { Outer::X * nested; X * global; };\n").run()
+          .test(dot("class0" + x + "class1[label = \"{ «datatype»\\nOuter}\"]\nclass2" + x + "class3[label = \"{ «datatype»\\nuser|- nested: X［*］ ｛ordered｝\\n- global: X［*］ ｛ordered｝\\n}\"]\n"
+                    "class3->class0" + aggregation + "class3->class2" + aggregation));
+
+    return tester.results();
+
+}
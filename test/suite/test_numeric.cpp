@@ -21,6 +21,8 @@
 
 #include <tester.hpp>
 
+#include <fstream>
+
 int main(int argc, char * argv[]) {
 
     tester_t tester("numeric");
@@ -126,6 +128,23 @@ int main(int argc, char * argv[]) {
     // complex
     tester.src2srcml("class foo { public: std::shared_ptr<const unsigned int const * const> bar; };").run().test("[«datatype»;foo|+ bar: number［*］ ｛ordered｝;]\n");
 
+    // names from a type config are numeric only in the run given the config
+    std::ofstream("test_numeric.cfg") << "# units\nnumeric meters\n";
+    std::ofstream("test_numeric_bad.cfg") << "distance meters\n";
+
+    srcuml_options config_options;
+    config_options.type_config = "test_numeric.cfg";
+
+    tester.src2srcml("class road { public: meters length; };").run(config_options)
+          .test("digraph hierarchy {\nnode[shape=record,style=filled,fillcolor=gray95]\nedge[dir=\"both\", arrowtail=\"empty\", arrowhead=\"empty\", labeldistance=\"2.0\"]\n"
+                "class0[label = \"{ «datatype»\\nroad|+ length: number\\n}\"]\n}\n");
+    tester.src2srcml("class road { public: meters length; };").run()
+          .test("digraph hierarchy {\nnode[shape=record,style=filled,fillcolor=gray95]\nedge[dir=\"both\", arrowtail=\"empty\", arrowhead=\"empty\", labeldistance=\"2.0\"]\n"
+                "class0[label = \"{ «datatype»\\nroad|+ length: meters\\n}\"]\n}\n");
+
+    config_options.type_config = "test_numeric_bad.cfg";
+    tester.src2srcml("class road { public: meters length; };").run(config_options).test_error("test_numeric_bad.cfg:1: unknown type category distance");
+
     return tester.results();
 
 }
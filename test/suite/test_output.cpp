@@ -0,0 +1,123 @@
+/**
+ * @file test_output.cpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcYUML.
+ *
+ * srcYUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * srcYUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcYUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tester.hpp>
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+static srcuml_options format_options(const std::string & format, const std::string & filename) {
+
+    srcuml_options options;
+    options.outputs.push_back(srcuml_options::output_target{ format, filename });
+
+    return options;
+
+}
+
+static std::string read_file(const std::string & filename) {
+
+    std::ifstream in(filename);
+    std::ostringstream contents;
+    contents << in.rdbuf();
+
+    return contents.str();
+
+}
+
+/** the outputs added for the formats and files, then the stream's file, or the error */
+static std::string add_outputs(const std::vector<std::string> & formats, const std::vector<std::string> & filenames) {
+
+    srcuml_options options;
+    try {
+
+        std::string output_filename = options.add_outputs(formats, filenames);
+
+        std::string added;
+        for(const srcuml_options::output_target & target : options.outputs)
+            added += target.format + " " + target.filename + "\n";
+
+        return added + output_filename;
+
+    } catch(const std::runtime_error & error) {
+
+        return error.what();
+
+    }
+
+}
+
+int main(int argc, char * argv[]) {
+
+    tester_t tester("output");
+
+    const std::string source = "class part { int id; };\nclass whole { part body; static int count; public: int get(int index) const; void use() { part local; } };\n";
+
+    tester.src2srcml(source).run(format_options("dot", "")).test(
+        "digraph hierarchy {\n"
+        "node[shape=record,style=filled,fillcolor=gray95]\n"
+        "edge[dir=\"both\", arrowtail=\"empty\", arrowhead=\"empty\", labeldistance=\"2.0\"]\n"
+        "class0[label = \"{ «datatype»\\npart|- id: number\\n}\"]\n"
+        "class1[label = \"{ «datatype»\\nwhole|- body: part\\n-̲ ̲c̲o̲u̲n̲t̲:̲ ̲n̲u̲m̲b̲e̲r̲\\n|+ get(index: number): number\\n+ use()\\n}\"]\n"
+        "class1->class0[arrowhead=\"vee\", arrowtail=\"diamond\"]\n"
+        "class1->class0[arrowhead=\"vee\", arrowtail=\"none\", style=\"dashed\"]\n"
+        "}\n"
+    );
+
+    // every format from one analysis, each the same as a run for it alone
+    srcuml_options options;
+    options.outputs.push_back(srcuml_options::output_target{ "dot", "test_output.dot" });
+    options.outputs.push_back(srcuml_options::output_target{ "yuml", "test_output.yuml" });
+    options.outputs.push_back(srcuml_options::output_target{ "json", "test_output.json" });
+    tester.src2srcml(source).run(options).test("");
+
+    for(const srcuml_options::output_target & target : options.outputs) {
+
+        const std::string single = tester.src2srcml(source).run(format_options(target.format, "")).get_output();
+        tester.output(read_file(target.filename)).test(single);
+
+        tester.src2srcml(source).run(format_options(target.format, target.filename)).test("");
+        tester.output(read_file(target.filename)).test(single);
+
+    }
+
+    // a single target goes to the stream, the default is dot
+    tester.src2srcml(source).run(format_options("yuml", "")).test_error("");
+    tester.src2srcml(source).run(format_options("svg", "")).test_error("Unknown output format: svg");
+
+    options = srcuml_options();
+    options.outputs.push_back(srcuml_options::output_target{ "dot", "" });
+    options.outputs.push_back(srcuml_options::output_target{ "yuml", "" });
+    tester.src2srcml(source).run(options).test("").test_error("Only one output format can be written to the output stream");
+
+    // formats paired with output files
+    tester.output(add_outputs({}, {})).test("");
+    tester.output(add_outputs({ "yuml" }, { "diagram.yuml" })).test("yuml \ndiagram.yuml");
+    tester.output(add_outputs({ "dot,yuml", "json" }, { "a.dot", "a.yuml", "a.json" })).test("dot a.dot\nyuml a.yuml\njson a.json\n");
+    tester.output(add_outputs({ "dot,yuml" }, { "a.dot" })).test("One output file is needed for each format");
+    tester.output(add_outputs({ "dot" }, { "a.dot", "b.dot" })).test("One output file is needed for each format");
+
+    return tester.results();
+
+}
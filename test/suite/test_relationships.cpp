@@ -21,6 +21,17 @@
 
 #include <tester.hpp>
 
+#include <string>
+
+static srcuml_options jobs_options(std::size_t jobs) {
+
+    srcuml_options options;
+    options.jobs = jobs;
+
+    return options;
+
+}
+
 int main(int argc, char * argv[]) {
 
     tester_t tester("relationships");
@@ -28,6 +39,30 @@ int main(int argc, char * argv[]) {
 	//tester.src2srcml("class Parent{}; class Child: public Parent{};").run().test("[][Parent]^-[Child]");
 	//tester.src2srcml("class Parent{}; class Child: public Parent{}; class Grandchild: public Child{};lass Parent{}; class Child: public Parent{}; class Grandchild: public Child{};").run().test("")
 
+    // more classes than one chunk of the analysis, edges are in the same order on any number of threads
+    const std::size_t CLASS_COUNT = 600;
+
+    std::string source;
+    for(std::size_t pos = 0; pos < CLASS_COUNT; ++pos) {
+
+        const std::string name = "c" + std::to_string(pos);
+        source += "class " + name;
+        if(pos) source += " : public c" + std::to_string(pos / 2);
+        source += " { c" + std::to_string(pos * 7 % CLASS_COUNT) + " * peer;";
+        source += " public: void use(c" + std::to_string(pos * 13 % CLASS_COUNT) + " value) {} };\n";
+
+    }
+
+    // the serial run finds generalization, aggregation, and dependency edges
+    tester.src2srcml(source).run(jobs_options(1))
+          .test_contains("class0->class1[arrowhead=\"none\"]\n")
+          .test_contains("class1->class7[arrowhead=\"none\", arrowtail=\"odiamond\"]\n")
+          .test_contains("class1->class13[arrowhead=\"vee\", arrowtail=\"none\", style=\"dashed\"]\n")
+          .test_error("");
+
+    const std::string single_threaded = tester.get_output();
+    tester.src2srcml(source).run(jobs_options(4)).test(single_threaded);
+
     return tester.results();
 
 }
\ No newline at end of file
@@ -0,0 +1,79 @@
+/**
+ * @file test_source.cpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcYUML.
+ *
+ * srcYUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * srcYUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcYUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tester.hpp>
+#include <srcuml_source.hpp>
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <fstream>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+/** the files found for the paths, one per line */
+static std::string get_files(const std::vector<std::string> & paths) {
+
+    srcuml_source source(paths);
+
+    std::string files;
+    for(std::size_t pos = 0; pos < source.size(); ++pos)
+        files += source.get_file(pos) + '\n';
+
+    return files;
+
+}
+
+int main(int argc, char * argv[]) {
+
+    tester_t tester("source");
+
+    // a tree with a link back up to its root
+    mkdir("test_source", 0700);
+    mkdir("test_source/sub", 0700);
+    std::ofstream("test_source/part.hpp") << "class part { int id; };\n";
+    std::ofstream("test_source/sub/whole.cpp") << "class whole { part * body; };\n";
+    std::ofstream("test_source/notes.txt") << "class notes {};\n";
+    std::ofstream("test_source/.hidden.hpp") << "class hidden {};\n";
+    symlink("..", "test_source/sub/up");
+
+    // sorted, only known extensions, hidden files skipped, and the link back up is not searched again
+    tester.output(get_files({ "test_source" })).test("test_source/part.hpp\ntest_source/sub/whole.cpp\n");
+
+    // a directory named twice, directly and through the link, is searched once
+    tester.output(get_files({ "test_source", "test_source/sub/up" })).test("test_source/part.hpp\ntest_source/sub/whole.cpp\n");
+
+    // a file named explicitly is converted even without a known extension
+    tester.output(get_files({ "test_source/notes.txt" })).test("test_source/notes.txt\n");
+
+    // converted in memory, the diagram is the diagram of the same units in an archive
+    tester.src2srcml({ { "test_source/part.hpp", "class part { int id; };\n" }, { "test_source/sub/whole.cpp", "class whole { part * body; };\n" } })
+          .run().test_contains("class1->class0[arrowhead=\"none\", arrowtail=\"odiamond\"]\n").test_error("");
+    const std::string diagram = tester.get_output();
+
+    tester.run_source({ "test_source" }).test(diagram);
+
+    tester.run_source({ "test_source/missing.hpp" }).test_error("Unable to open input: test_source/missing.hpp");
+
+    return tester.results();
+
+}
@@ -0,0 +1,42 @@
+/**
+ * @file test_summary.cpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcYUML.
+ *
+ * srcYUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * srcYUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcYUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tester.hpp>
+
+int main(int argc, char * argv[]) {
+
+    tester_t tester("summary");
+
+    // class data is freed once collected, the summary keeps attributes, operations, and used types
+    tester.src2srcml("class part { int id; };\nclass whole { part body; static int count; public: int get(int index) const; void use() { part local; } };\n").run().test(
+        "digraph hierarchy {\n"
+        "node[shape=record,style=filled,fillcolor=gray95]\n"
+        "edge[dir=\"both\", arrowtail=\"empty\", arrowhead=\"empty\", labeldistance=\"2.0\"]\n"
+        "class0[label = \"{ «datatype»\\npart|- id: number\\n}\"]\n"
+        "class1[label = \"{ «datatype»\\nwhole|- body: part\\n-̲ ̲c̲o̲u̲n̲t̲:̲ ̲n̲u̲m̲b̲e̲r̲\\n|+ get(index: number): number\\n+ use()\\n}\"]\n"
+        "class1->class0[arrowhead=\"vee\", arrowtail=\"diamond\"]\n"
+        "class1->class0[arrowhead=\"vee\", arrowtail=\"none\", style=\"dashed\"]\n"
+        "}\n"
+    );
+
+    return tester.results();
+
+}
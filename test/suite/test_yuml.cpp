@@ -0,0 +1,109 @@
+/**
+ * @file test_yuml.cpp
+ *
+ * @copyright Copyright (C) 2016 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of srcYUML.
+ *
+ * srcYUML is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * srcYUML is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with srcYUML.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tester.hpp>
+
+#include <srcuml_model.hpp>
+#include <srcuml_input.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+
+static void write_file(const std::string & filename, const std::string & contents) {
+
+    std::ofstream(filename) << contents;
+
+}
+
+static std::string read_file(const std::string & filename) {
+
+    std::ifstream in(filename);
+    std::ostringstream contents;
+    contents << in.rdbuf();
+
+    return contents.str();
+
+}
+
+/** exit status of srcyuml2dot run with the arguments */
+static int srcyuml2dot(const std::string & arguments) {
+
+    return std::system(("\"" + std::string(SRCYUML2DOT) + "\" " + arguments).c_str());
+
+}
+
+int main(int argc, char * argv[]) {
+
+    tester_t tester("yuml");
+
+    const std::string model_file = "test_yuml.srcuml";
+
+    srcuml_options yuml_options;
+    yuml_options.outputs.push_back(srcuml_options::output_target{ "yuml", "" });
+
+    srcuml_options model_options;
+    model_options.model_file = model_file;
+
+    // generalization, realization, composition, aggregation, and dependency from the source
+    tester.src2srcml("class shape { public: virtual double area() = 0; };\n"
+                     "class square : public shape { public: double area() { return side; } int side; };\n"
+                     "class base { int id; };\n"
+                     "class derived : public base { int count; };\n"
+                     "class whole { base body; derived * spare; void use(shape * s) {} };\n").run(model_options);
+
+    // the analysis writes no plain or bidirectional associations, add them to the model
+    {
+        srcuml_input input(model_file.c_str());
+        srcuml_model model(input.get_data(), input.get_size(), model_file);
+
+        std::vector<srcuml_relationship> relationships = model.get_relationships();
+        relationships.emplace_back(2, "", 3, "peer", ASSOCIATION);
+        relationships.emplace_back(1, "back", 4, "peer", BIDIRECTIONAL);
+        srcuml_model::save(model_file, model.get_classes(), relationships);
+    }
+
+    // every kind of relation is written to yUML
+    const std::string diagram = tester.run_file(model_file, yuml_options).get_output();
+    for(const std::string & relation : { "]^-[", "]^-.-[", "]++-", "]<>-", "]-.->[", "]-peer>[", "]<back-peer>[" })
+        tester.test_contains(relation);
+
+    // srcyuml2dot converts it to the same DOT as the model
+    const std::string dot = tester.run_file(model_file).get_output();
+    write_file("test_yuml.yuml", diagram);
+    tester.output(std::to_string(srcyuml2dot("test_yuml.yuml test_yuml.dot"))).test("0");
+    tester.output(read_file("test_yuml.dot")).test(dot);
+
+    // malformed yUML is reported with its line
+    write_file("test_yuml_invalid.yuml", "[A]\nfoo\n");
+    tester.output(std::to_string(srcyuml2dot("test_yuml_invalid.yuml test_yuml_invalid.dot 2> test_yuml_invalid.err") != 0)).test("1");
+    tester.output(read_file("test_yuml_invalid.err")).test("srcyuml2dot: Invalid yUML on line 2: expected [ at the start of the box\n");
+
+    for(const char * filename : { "test_yuml.yuml", "test_yuml.dot", "test_yuml_invalid.yuml", "test_yuml_invalid.dot", "test_yuml_invalid.err" })
+        std::remove(filename);
+    std::remove(model_file.c_str());
+
+    return tester.results();
+
+}